@@ -0,0 +1,68 @@
+#include "Base32.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Arguments are secret sizes in bytes: COMPACT, STANDARD, EXTENDED and the
+// largest SHA-512 block-sized key.
+static void secretSizes(benchmark::internal::Benchmark *bench) {
+  for (int64_t bytes : {16, 20, 32, 64}) {
+    bench->Arg(bytes);
+  }
+}
+
+static std::vector<uint8_t> makeBytes(size_t size) {
+  std::vector<uint8_t> bytes(size);
+  for (size_t i = 0; i < size; ++i) {
+    bytes[i] = static_cast<uint8_t>(i * 37 + 11);
+  }
+  return bytes;
+}
+
+static void BM_Base32Encode(benchmark::State &state) {
+  const std::vector<uint8_t> bytes = makeBytes(state.range(0));
+  std::string out(Base32::encodedSize(bytes.size(), false), '\0');
+
+  for (auto _ : state) {
+    size_t written = Base32::encode(bytes.data(), bytes.size(), out.data(),
+                                    false);
+    benchmark::DoNotOptimize(written);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+BENCHMARK(BM_Base32Encode)->Apply(secretSizes);
+
+static void BM_Base32Decode(benchmark::State &state) {
+  const std::string encoded = Base32::encode(makeBytes(state.range(0)));
+  std::vector<uint8_t> out(Base32::maxDecodedSize(encoded.size()));
+
+  for (auto _ : state) {
+    size_t written = Base32::decode(encoded, out.data());
+    benchmark::DoNotOptimize(written);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * encoded.size());
+}
+BENCHMARK(BM_Base32Decode)->Apply(secretSizes);
+
+// The allocating overload used by Secret::fromBase32, on a user-formatted
+// secret with separators and lowercase letters.
+static void BM_Base32DecodeFormatted(benchmark::State &state) {
+  std::string encoded = Base32::encode(makeBytes(state.range(0)));
+  std::string formatted;
+  for (size_t i = 0; i < encoded.size(); ++i) {
+    if (i > 0 && i % 4 == 0) {
+      formatted += ' ';
+    }
+    formatted += static_cast<char>(encoded[i] | 0x20);
+  }
+
+  for (auto _ : state) {
+    std::vector<uint8_t> bytes = Base32::decode(formatted);
+    benchmark::DoNotOptimize(bytes.data());
+  }
+  state.SetBytesProcessed(state.iterations() * formatted.size());
+}
+BENCHMARK(BM_Base32DecodeFormatted)->Apply(secretSizes);
@@ -0,0 +1,49 @@
+#include "Hex.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Arguments are input sizes in bytes: STANDARD and EXTENDED secrets, the
+// largest SHA-512 block-sized key, and a bulk buffer for the vector paths.
+static void hexSizes(benchmark::internal::Benchmark *bench) {
+  for (int64_t bytes : {20, 32, 64, 4096}) {
+    bench->Arg(bytes);
+  }
+}
+
+static std::vector<uint8_t> makeBytes(size_t size) {
+  std::vector<uint8_t> bytes(size);
+  for (size_t i = 0; i < size; ++i) {
+    bytes[i] = static_cast<uint8_t>(i * 37 + 11);
+  }
+  return bytes;
+}
+
+static void BM_HexEncode(benchmark::State &state) {
+  const std::vector<uint8_t> bytes = makeBytes(state.range(0));
+  std::string out(Hex::encodedSize(bytes.size()), '\0');
+
+  for (auto _ : state) {
+    Hex::encode(bytes.data(), bytes.size(), out.data());
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+BENCHMARK(BM_HexEncode)->Apply(hexSizes);
+
+static void BM_HexDecode(benchmark::State &state) {
+  const std::vector<uint8_t> bytes = makeBytes(state.range(0));
+  std::string encoded(Hex::encodedSize(bytes.size()), '\0');
+  Hex::encode(bytes.data(), bytes.size(), encoded.data());
+  std::vector<uint8_t> out(Hex::decodedSize(encoded.size()));
+
+  for (auto _ : state) {
+    Hex::Status status = Hex::decode(encoded, out.data());
+    benchmark::DoNotOptimize(status);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * encoded.size());
+}
+BENCHMARK(BM_HexDecode)->Apply(hexSizes);
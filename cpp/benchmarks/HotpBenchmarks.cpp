@@ -0,0 +1,238 @@
+#include "CodeRing.hpp"
+#include "Hotp.hpp"
+#include "KeyCache.hpp"
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Base32 of the RFC 4226 test secret "12345678901234567890".
+static const std::string SECRET = "GEZDGNBVGY3TQOJQGEZDGNBVGY3TQOJQ";
+static constexpr int DIGITS = 6;
+
+// Every heap allocation in the benchmark binary, so the formatting
+// benchmarks can prove they make none.
+static std::atomic<size_t> allocations{0};
+
+void *operator new(size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *pointer = std::malloc(size == 0 ? 1 : size)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept { std::free(pointer); }
+
+void operator delete(void *pointer, size_t) noexcept { std::free(pointer); }
+
+// Same steps as HybridNitroHotp::generate without the JSI conversions: key
+// cache lookup, HMAC, truncation and formatting into a std::string.
+static void BM_HotpGenerate(benchmark::State &state) {
+  uint64_t counter = 0;
+  for (auto _ : state) {
+    std::shared_ptr<const HMAC::Key> key =
+        KeyCache::shared().get(SECRET, HMAC::Algorithm::SHA1);
+    uint32_t otp = HOTP::compute(*key, counter++, DIGITS);
+    std::string code(DIGITS, '0');
+    HOTP::format(otp, DIGITS, code.data());
+    benchmark::DoNotOptimize(code.data());
+  }
+}
+BENCHMARK(BM_HotpGenerate);
+
+// The per-code work of generate() once the key is prepared: HMAC,
+// truncation and Utils::formatOtp's formatting into a small string. Reports
+// heap allocations per code, which must be zero.
+static void BM_HotpFormatAllocations(benchmark::State &state) {
+  const int digits = static_cast<int>(state.range(0));
+  std::shared_ptr<const HMAC::Key> key =
+      KeyCache::prepare(SECRET, HMAC::Algorithm::SHA1);
+  uint64_t counter = 0;
+
+  const size_t before = allocations.load(std::memory_order_relaxed);
+  for (auto _ : state) {
+    uint32_t otp = HOTP::compute(*key, counter++, digits);
+    std::string code(static_cast<size_t>(digits), '0');
+    HOTP::format(otp, digits, code.data());
+    benchmark::DoNotOptimize(code.data());
+  }
+  const size_t count = allocations.load(std::memory_order_relaxed) - before;
+
+  state.counters["allocs_per_code"] =
+      static_cast<double>(count) / static_cast<double>(state.iterations());
+  if (count != 0) {
+    state.SkipWithError("Generating a code allocated on the heap");
+  }
+}
+BENCHMARK(BM_HotpFormatAllocations)->ArgName("digits")->Arg(6)->Arg(7)->Arg(8);
+
+// generate() with a cold cache: Base32 decoding and key preparation on
+// every call.
+static void BM_HotpGenerateUncached(benchmark::State &state) {
+  uint64_t counter = 0;
+  for (auto _ : state) {
+    std::shared_ptr<const HMAC::Key> key =
+        KeyCache::prepare(SECRET, HMAC::Algorithm::SHA1);
+    uint32_t otp = HOTP::compute(*key, counter++, DIGITS);
+    std::string code(DIGITS, '0');
+    HOTP::format(otp, DIGITS, code.data());
+    benchmark::DoNotOptimize(code.data());
+  }
+}
+BENCHMARK(BM_HotpGenerateUncached);
+
+// generate() served from a precomputed CodeRing: the HMAC is replaced by an
+// atomic load. The counter stays inside the filled range, so no refill runs.
+static void BM_HotpGenerateRing(benchmark::State &state) {
+  using margelo::nitro::totp::CodeRing;
+  auto ring = std::make_shared<CodeRing>(
+      KeyCache::prepare(SECRET, HMAC::Algorithm::SHA1), 30, DIGITS, 64);
+  ring->fill(0);
+  uint64_t counter = 0;
+  for (auto _ : state) {
+    std::optional<uint32_t> otp = ring->get(counter++ % 32);
+    std::string code(DIGITS, '0');
+    HOTP::format(*otp, DIGITS, code.data());
+    benchmark::DoNotOptimize(code.data());
+  }
+}
+BENCHMARK(BM_HotpGenerateRing);
+
+// Worst case of HybridNitroHotp::validate: a code that matches no counter
+// in the window, so all 2 * window + 1 candidates are computed.
+static void BM_HotpValidateWindow(benchmark::State &state) {
+  const int window = static_cast<int>(state.range(0));
+  const uint64_t counter = 1000000;
+  std::shared_ptr<const HMAC::Key> key =
+      KeyCache::shared().get(SECRET, HMAC::Algorithm::SHA1);
+
+  // Pick a code that does not occur anywhere in the window.
+  const std::string otp = "000000";
+  uint32_t expected = 0;
+  HOTP::parse(otp, DIGITS, expected);
+  if (HOTP::find(*key, counter, window, DIGITS, expected)) {
+    state.SkipWithError("Benchmark code unexpectedly matches the window");
+    return;
+  }
+
+  for (auto _ : state) {
+    uint32_t parsed = 0;
+    HOTP::parse(otp, DIGITS, parsed);
+    std::shared_ptr<const HMAC::Key> cached =
+        KeyCache::shared().get(SECRET, HMAC::Algorithm::SHA1);
+    std::optional<int> delta =
+        HOTP::find(*cached, counter, window, DIGITS, parsed);
+    benchmark::DoNotOptimize(delta);
+  }
+  state.SetItemsProcessed(state.iterations() * (2 * window + 1));
+}
+BENCHMARK(BM_HotpValidateWindow)
+    ->ArgName("window")
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000);
+
+// Same worst case with the constantTime option; compare against
+// BM_HotpValidateWindow for the cost of the branch-free comparison.
+static void BM_HotpValidateWindowConstantTime(benchmark::State &state) {
+  const int window = static_cast<int>(state.range(0));
+  const uint64_t counter = 1000000;
+  std::shared_ptr<const HMAC::Key> key =
+      KeyCache::shared().get(SECRET, HMAC::Algorithm::SHA1);
+  const uint32_t otp = 0;
+
+  for (auto _ : state) {
+    std::optional<int> delta =
+        HOTP::findConstantTime(*key, counter, window, DIGITS, otp);
+    benchmark::DoNotOptimize(delta);
+  }
+  state.SetItemsProcessed(state.iterations() * (2 * window + 1));
+}
+BENCHMARK(BM_HotpValidateWindowConstantTime)
+    ->ArgName("window")
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000);
+
+// A code matching the first candidate searched, the counter itself. The
+// early-exit scan returns after one chunk; the constant-time scan should take
+// as long as in the no-match case.
+static void BM_HotpValidateFirstMatch(benchmark::State &state) {
+  const int window = static_cast<int>(state.range(0));
+  const bool constantTime = state.range(1) != 0;
+  const uint64_t counter = 1000000;
+  std::shared_ptr<const HMAC::Key> key =
+      KeyCache::shared().get(SECRET, HMAC::Algorithm::SHA1);
+  const uint32_t otp = HOTP::compute(*key, counter, DIGITS);
+
+  for (auto _ : state) {
+    std::optional<int> delta =
+        constantTime
+            ? HOTP::findConstantTime(*key, counter, window, DIGITS, otp)
+            : HOTP::find(*key, counter, window, DIGITS, otp);
+    benchmark::DoNotOptimize(delta);
+  }
+}
+BENCHMARK(BM_HotpValidateFirstMatch)
+    ->ArgNames({"window", "constantTime"})
+    ->ArgsProduct({{100, 1000}, {0, 1}});
+
+// The generateMany path: one shared counter over many prepared keys.
+static void BM_HotpComputeMany(benchmark::State &state) {
+  const size_t count = static_cast<size_t>(state.range(0));
+
+  std::vector<std::shared_ptr<const HMAC::Key>> keys;
+  std::vector<const HMAC::Key *> keyPointers;
+  for (size_t i = 0; i < count; ++i) {
+    std::string secret = SECRET;
+    secret[i % secret.size()] = static_cast<char>('A' + i % 26);
+    keys.push_back(KeyCache::prepare(secret, HMAC::Algorithm::SHA1));
+    keyPointers.push_back(keys.back().get());
+  }
+  std::vector<uint64_t> counters(count, 1);
+  std::vector<uint32_t> otps(count);
+
+  for (auto _ : state) {
+    HOTP::computeMany(keyPointers.data(), counters.data(), count, DIGITS,
+                      otps.data());
+    benchmark::DoNotOptimize(otps.data());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_HotpComputeMany)->ArgName("count")->Arg(8)->Arg(64)->Arg(512);
+
+// The per-worker step of HybridNitroTotp::validateMany: many prepared keys,
+// one code each and the default window of 1, so three candidates per key,
+// all packed into shared multi-buffer batches.
+static void BM_HotpFindMany(benchmark::State &state) {
+  const size_t count = static_cast<size_t>(state.range(0));
+  constexpr int WINDOW = 1;
+
+  std::vector<std::shared_ptr<const HMAC::Key>> keys;
+  std::vector<const HMAC::Key *> keyPointers;
+  std::vector<uint32_t> otps;
+  for (size_t i = 0; i < count; ++i) {
+    std::string secret = SECRET;
+    secret[i % secret.size()] = static_cast<char>('A' + i % 26);
+    keys.push_back(KeyCache::prepare(secret, HMAC::Algorithm::SHA1));
+    keyPointers.push_back(keys.back().get());
+    otps.push_back(HOTP::compute(*keys.back(), 100, DIGITS));
+  }
+  std::vector<int32_t> deltas(count);
+
+  for (auto _ : state) {
+    HOTP::findMany(keyPointers.data(), otps.data(), count, 100, WINDOW,
+                   DIGITS, deltas.data());
+    benchmark::DoNotOptimize(deltas.data());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_HotpFindMany)->ArgName("count")->Arg(64)->Arg(256)->Arg(4096);
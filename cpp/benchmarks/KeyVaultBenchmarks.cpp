@@ -0,0 +1,57 @@
+#include "Hotp.hpp"
+#include "KeyVault.hpp"
+#include "Random.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+// A vault of `count` 20-byte SHA-1 TOTP accounts with ids 0, 2, 4, ...
+static std::string writeVault(size_t count) {
+  std::string path = "nitrototp_benchmark_" + std::to_string(count) + ".vault";
+  std::vector<KeyVault::Record> records(count);
+  for (size_t i = 0; i < count; ++i) {
+    KeyVault::Record &record = records[i];
+    record.id = i * 2;
+    record.period = 30;
+    record.algorithm = static_cast<uint8_t>(HMAC::Algorithm::SHA1);
+    record.digits = 6;
+    record.keySize = 20;
+    Random::fill(record.key, record.keySize);
+  }
+  KeyVault::write(path, std::move(records));
+  return path;
+}
+
+// Mapping and header checks only; flat in the number of accounts.
+static void BM_KeyVaultOpen(benchmark::State &state) {
+  const std::string path = writeVault(static_cast<size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    KeyVault vault(path);
+    benchmark::DoNotOptimize(vault.size());
+  }
+  std::remove(path.c_str());
+}
+BENCHMARK(BM_KeyVaultOpen)->ArgName("count")->Arg(100)->Arg(100000);
+
+// Same steps as HybridNitroKeyVault::generate for a lookup by id: binary
+// search, HMAC key setup from the mapped record and one HOTP computation.
+static void BM_KeyVaultGenerate(benchmark::State &state) {
+  const size_t count = static_cast<size_t>(state.range(0));
+  const std::string path = writeVault(count);
+  KeyVault vault(path);
+  uint64_t id = 0;
+
+  for (auto _ : state) {
+    size_t index = *vault.indexOf(id);
+    std::shared_ptr<const HMAC::Key> key = vault.prepareKey(index);
+    benchmark::DoNotOptimize(HOTP::compute(*key, 56666666, 6));
+    id = (id + 2 * 7919) % (2 * count);
+  }
+  state.SetItemsProcessed(state.iterations());
+  std::remove(path.c_str());
+}
+BENCHMARK(BM_KeyVaultGenerate)->ArgName("count")->Arg(100)->Arg(100000);
@@ -0,0 +1,158 @@
+#include "Hmac.hpp"
+#include "MigrationPayload.hpp"
+#include "OtpAuthUri.hpp"
+#include "SecureMemory.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using margelo::nitro::totp::MigrationAccount;
+using margelo::nitro::totp::OtpAuthArena;
+using margelo::nitro::totp::OtpAuthUri;
+namespace Migration = margelo::nitro::totp::Migration;
+namespace OtpAuth = margelo::nitro::totp::OtpAuth;
+
+// Typical export of `count` accounts, with an escaped issuer and label.
+static std::vector<std::string> makeUris(size_t count) {
+  std::vector<std::string> uris;
+  uris.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    uris.push_back("otpauth://totp/ACME%20Co:user" + std::to_string(i) +
+                   "%40example.com?secret=HXDMVJECJJWSRB3HWIZR4IFUGFTMXBOZ"
+                   "&issuer=ACME%20Co&algorithm=SHA1&digits=6&period=30");
+  }
+  return uris;
+}
+
+// Same steps as HybridNitroOtpAuth::parseMany without the JSI conversions:
+// one arena for the batch and one parse per URI.
+static void BM_OtpAuthParseMany(benchmark::State &state) {
+  const std::vector<std::string> uris =
+      makeUris(static_cast<size_t>(state.range(0)));
+  size_t capacity = 0;
+  for (const std::string &uri : uris) {
+    capacity += uri.size();
+  }
+
+  for (auto _ : state) {
+    OtpAuthArena arena(capacity);
+    OtpAuthUri parsed;
+    for (const std::string &uri : uris) {
+      benchmark::DoNotOptimize(OtpAuth::parse(uri, arena, parsed));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * uris.size());
+}
+BENCHMARK(BM_OtpAuthParseMany)->ArgName("count")->Arg(1)->Arg(100)->Arg(1000);
+
+static void BM_OtpAuthBuild(benchmark::State &state) {
+  OtpAuthUri uri;
+  uri.issuer = "ACME Co";
+  uri.account = "user@example.com";
+  uri.secret = "HXDMVJECJJWSRB3HWIZR4IFUGFTMXBOZ";
+
+  for (auto _ : state) {
+    std::string result;
+    OtpAuth::build(uri, true, result);
+    benchmark::DoNotOptimize(result.data());
+  }
+}
+BENCHMARK(BM_OtpAuthBuild);
+
+static void appendVarint(std::string &out, uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+static void appendField(std::string &out, uint32_t field,
+                        const std::string &bytes) {
+  appendVarint(out, field << 3 | 2);
+  appendVarint(out, bytes.size());
+  out.append(bytes);
+}
+
+static void appendField(std::string &out, uint32_t field, uint64_t value) {
+  appendVarint(out, field << 3);
+  appendVarint(out, value);
+}
+
+// otpauth-migration URI carrying `count` SHA-1, 6-digit TOTP accounts with
+// 20-byte secrets, Base64-encoded and percent-escaped like a real export.
+static std::string makeMigrationUri(size_t count) {
+  std::string payload;
+  for (size_t i = 0; i < count; ++i) {
+    std::string account;
+    appendField(account, 1, std::string(20, static_cast<char>(i)));
+    appendField(account, 2, "user" + std::to_string(i) + "@example.com");
+    appendField(account, 3, std::string("ACME Co"));
+    appendField(account, 4, uint64_t{1});
+    appendField(account, 5, uint64_t{1});
+    appendField(account, 6, uint64_t{2});
+    appendField(payload, 1, account);
+  }
+  appendField(payload, 2, uint64_t{1});
+
+  static constexpr char chars[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789%2B%2F";
+  std::string uri = "otpauth-migration://offline?data=";
+  uint32_t buffer = 0;
+  int bits = 0;
+  auto appendChar = [&uri](uint32_t value) {
+    if (value < 62) {
+      uri.push_back(chars[value]);
+    } else {
+      uri.append(chars + 62 + (value - 62) * 3, 3);
+    }
+  };
+  for (char c : payload) {
+    buffer = buffer << 8 | static_cast<uint8_t>(c);
+    bits += 8;
+    while (bits >= 6) {
+      bits -= 6;
+      appendChar(buffer >> bits & 63);
+    }
+  }
+  if (bits > 0) {
+    appendChar(buffer << (6 - bits) & 63);
+  }
+  return uri;
+}
+
+// Same steps as HybridNitroOtpAuth::parseMigration without the JSI
+// conversions: URI and Base64 decoding, one pass over the protobuf and an
+// HMAC key prepared straight from each secret.
+static void BM_MigrationDecode(benchmark::State &state) {
+  const std::string uri =
+      makeMigrationUri(static_cast<size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    std::vector<uint8_t> payload;
+    std::vector<std::shared_ptr<const HMAC::Key>> keys;
+    keys.reserve(static_cast<size_t>(state.range(0)));
+    bool valid =
+        Migration::decodeUri(uri, payload) &&
+        Migration::decode(payload.data(), payload.size(),
+                          [&keys](const MigrationAccount &account) {
+                            keys.push_back(std::make_shared<const HMAC::Key>(
+                                account.algorithm, account.secret,
+                                account.secretSize));
+                          });
+    SecureMemory::wipe(payload.data(), payload.size());
+    if (!valid) {
+      state.SkipWithError("Benchmark payload failed to decode");
+      return;
+    }
+    benchmark::DoNotOptimize(keys.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * uri.size());
+}
+BENCHMARK(BM_MigrationDecode)
+    ->ArgName("accounts")
+    ->Arg(10)
+    ->Arg(1000)
+    ->Arg(5000);
@@ -0,0 +1,61 @@
+#include "Base32.hpp"
+#include "Secret.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Same steps as HybridNitroSecret::generate: random bytes from the system
+// CSPRNG, Base32 encoding and cleanup of the padding.
+static void BM_SecretGenerate(benchmark::State &state) {
+  const size_t size = static_cast<size_t>(state.range(0));
+
+  for (auto _ : state) {
+    Secret secret(std::vector<uint8_t>(), size);
+    std::string base32 = Base32::clean(secret.getBase32());
+    benchmark::DoNotOptimize(base32.data());
+  }
+}
+BENCHMARK(BM_SecretGenerate)->ArgName("bytes")->Arg(16)->Arg(20)->Arg(32);
+
+// Random bytes alone, to separate CSPRNG cost from encoding.
+static void BM_SecretRandomBytes(benchmark::State &state) {
+  const size_t size = static_cast<size_t>(state.range(0));
+
+  for (auto _ : state) {
+    std::vector<uint8_t> bytes = Secret::generateRandomBytes(size);
+    benchmark::DoNotOptimize(bytes.data());
+  }
+  state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_SecretRandomBytes)->ArgName("bytes")->Arg(16)->Arg(20)->Arg(32);
+
+// Same steps as HybridNitroSecret::generateMany: one CSPRNG draw for all
+// secrets and unpadded Base32 into one buffer. Compare items_per_second with
+// BM_SecretGenerate, which pays for the draw, padding and clean per secret.
+static void BM_SecretGenerateMany(benchmark::State &state) {
+  const size_t count = static_cast<size_t>(state.range(0));
+
+  for (auto _ : state) {
+    std::vector<std::string> secrets = Secret::generateBase32(count, 20);
+    benchmark::DoNotOptimize(secrets.data());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_SecretGenerateMany)
+    ->ArgName("count")
+    ->Arg(1)
+    ->Arg(1000)
+    ->Arg(10000);
+
+// The decode step of HybridNitroHotp::generateMany. Key bytes land in a
+// recycled slab slot, so the loop does not touch the heap.
+static void BM_SecretFromBase32(benchmark::State &state) {
+  const std::string base32 = "JBSWY3DPEHPK3PXPJBSWY3DPEHPK3PXP";
+
+  for (auto _ : state) {
+    Secret secret = Secret::fromBase32(base32);
+    benchmark::DoNotOptimize(secret.getBytes().data());
+  }
+}
+BENCHMARK(BM_SecretFromBase32);
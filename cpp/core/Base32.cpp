@@ -1,95 +1,202 @@
 #include "Base32.hpp"
-#include <cctype>
+#include <array>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define NITRO_TOTP_BASE32_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define NITRO_TOTP_BASE32_NEON 1
+#endif
 
 namespace Base32 {
 
 // Base32 encoding table
-static const std::string base32Chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
-
-// Base32 lookup table for decoding
-static int base32Lookup[256] = {-1};
+static constexpr char base32Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
 
-void initializeBase32Lookup() {
-  static bool initialized = false;
-  if (initialized)
-    return;
-  initialized = true;
+// Base32 decoding table: 0-31 for alphabet characters (either case), SKIP for
+// characters that are ignored and END for the characters that stop decoding.
+static constexpr int8_t SKIP = -1;
+static constexpr int8_t END = -2;
 
-  // Map valid Base32 characters to their values
+static constexpr std::array<int8_t, 256> makeDecodeTable() {
+  std::array<int8_t, 256> table{};
+  for (auto &value : table) {
+    value = SKIP;
+  }
   for (int i = 0; i < 32; ++i) {
-    unsigned char upper = static_cast<unsigned char>(base32Chars[i]);
-    unsigned char lower =
-        static_cast<unsigned char>(std::tolower(base32Chars[i]));
-    base32Lookup[upper] = i;
-    base32Lookup[lower] = i;
+    unsigned char c = static_cast<unsigned char>(base32Chars[i]);
+    table[c] = static_cast<int8_t>(i);
+    if (c >= 'A' && c <= 'Z') {
+      table[c - 'A' + 'a'] = static_cast<int8_t>(i);
+    }
   }
+  table[static_cast<unsigned char>('=')] = END;
+  table[0] = END;
+  return table;
 }
 
-// Implement the encode function
-std::string encode(const std::vector<uint8_t> &data) {
-  std::string result;
+static constexpr std::array<int8_t, 256> base32Lookup = makeDecodeTable();
 
-  int index = 0;
-  int currByte, nextByte;
-  int digit;
-
-  size_t i = 0;
-  while (i < data.size()) {
-    currByte = data[i];
-
-    if (index > 3) {
-      if ((i + 1) < data.size()) {
-        nextByte = data[i + 1];
-      } else {
-        nextByte = 0;
-      }
+// Packs eight 5-bit values into five bytes.
+static inline void packBlock(const uint8_t *values, uint8_t *out) {
+  uint64_t block = 0;
+  for (int i = 0; i < 8; ++i) {
+    block = (block << 5) | values[i];
+  }
+  out[0] = static_cast<uint8_t>(block >> 32);
+  out[1] = static_cast<uint8_t>(block >> 24);
+  out[2] = static_cast<uint8_t>(block >> 16);
+  out[3] = static_cast<uint8_t>(block >> 8);
+  out[4] = static_cast<uint8_t>(block);
+}
 
-      digit = ((currByte & (0xFF >> index)) << (index - 3)) |
-              (nextByte >> (8 - (index - 3)));
-      index = (index + 5) % 8;
-      i++;
-    } else {
-      digit = (currByte >> (8 - (index + 5))) & 0x1F;
-      index = (index + 5) % 8;
-      if (index == 0) {
-        i++;
-      }
+// Translates 16 characters to their 5-bit values. Returns false if any of
+// them is not an alphabet character, in which case the caller falls back to
+// the scalar loop for this stretch.
+static inline bool translate16(const char *input, uint8_t *values) {
+#if NITRO_TOTP_BASE32_SSE2
+  const __m128i c =
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(input));
+  // Signed compares: bytes >= 0x80 are negative and fail every range check.
+  auto inRange = [](__m128i x, char lo, char hi) {
+    return _mm_and_si128(_mm_cmpgt_epi8(x, _mm_set1_epi8(lo - 1)),
+                         _mm_cmplt_epi8(x, _mm_set1_epi8(hi + 1)));
+  };
+  const __m128i lower = inRange(c, 'a', 'z');
+  const __m128i upper =
+      _mm_sub_epi8(c, _mm_and_si128(lower, _mm_set1_epi8(0x20)));
+  const __m128i isAlpha = inRange(upper, 'A', 'Z');
+  const __m128i isDigit = inRange(c, '2', '7');
+  if (_mm_movemask_epi8(_mm_or_si128(isAlpha, isDigit)) != 0xFFFF) {
+    return false;
+  }
+  const __m128i alpha =
+      _mm_and_si128(isAlpha, _mm_sub_epi8(upper, _mm_set1_epi8('A')));
+  const __m128i digit =
+      _mm_and_si128(isDigit, _mm_sub_epi8(c, _mm_set1_epi8('2' - 26)));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(values),
+                   _mm_or_si128(alpha, digit));
+  return true;
+#elif NITRO_TOTP_BASE32_NEON
+  const uint8x16_t c = vld1q_u8(reinterpret_cast<const uint8_t *>(input));
+  auto inRange = [](uint8x16_t x, uint8_t lo, uint8_t hi) {
+    return vandq_u8(vcgeq_u8(x, vdupq_n_u8(lo)), vcleq_u8(x, vdupq_n_u8(hi)));
+  };
+  const uint8x16_t lower = inRange(c, 'a', 'z');
+  const uint8x16_t upper = vsubq_u8(c, vandq_u8(lower, vdupq_n_u8(0x20)));
+  const uint8x16_t isAlpha = inRange(upper, 'A', 'Z');
+  const uint8x16_t isDigit = inRange(c, '2', '7');
+  if (vminvq_u8(vorrq_u8(isAlpha, isDigit)) != 0xFF) {
+    return false;
+  }
+  const uint8x16_t alpha = vandq_u8(isAlpha, vsubq_u8(upper, vdupq_n_u8('A')));
+  const uint8x16_t digit =
+      vandq_u8(isDigit, vsubq_u8(c, vdupq_n_u8('2' - 26)));
+  vst1q_u8(values, vorrq_u8(alpha, digit));
+  return true;
+#else
+  for (int i = 0; i < 16; ++i) {
+    int8_t value = base32Lookup[static_cast<unsigned char>(input[i])];
+    if (value < 0) {
+      return false;
     }
+    values[i] = static_cast<uint8_t>(value);
+  }
+  return true;
+#endif
+}
 
-    result += base32Chars[digit];
+size_t encode(const uint8_t *data, size_t size, char *out, bool padding) {
+  char *start = out;
+
+  // Full 5-byte groups map to 8 characters.
+  size_t i = 0;
+  for (; i + 5 <= size; i += 5) {
+    uint64_t block = (static_cast<uint64_t>(data[i]) << 32) |
+                     (static_cast<uint64_t>(data[i + 1]) << 24) |
+                     (static_cast<uint64_t>(data[i + 2]) << 16) |
+                     (static_cast<uint64_t>(data[i + 3]) << 8) |
+                     static_cast<uint64_t>(data[i + 4]);
+    for (int j = 7; j >= 0; --j) {
+      out[j] = base32Chars[block & 0x1F];
+      block >>= 5;
+    }
+    out += 8;
   }
 
-  // Add padding
-  while (result.size() % 8 != 0) {
-    result += '=';
+  // Trailing 1-4 bytes: zero-fill the last group and emit only the
+  // characters that carry input bits.
+  size_t rest = size - i;
+  if (rest > 0) {
+    uint64_t block = 0;
+    for (size_t j = 0; j < 5; ++j) {
+      block = (block << 8) | (j < rest ? data[i + j] : 0);
+    }
+    size_t chars = (rest * 8 + 4) / 5;
+    for (size_t j = 0; j < chars; ++j) {
+      out[j] = base32Chars[(block >> (35 - 5 * j)) & 0x1F];
+    }
+    out += chars;
+    if (padding) {
+      for (size_t j = chars; j < 8; ++j) {
+        *out++ = '=';
+      }
+    }
   }
 
-  return result;
+  return static_cast<size_t>(out - start);
 }
 
-// Implement the decode function
-std::vector<uint8_t> decode(const std::string &base32String) {
-  initializeBase32Lookup();
-
-  std::vector<uint8_t> result;
+size_t decode(std::string_view input, uint8_t *out) {
+  uint8_t *start = out;
+  const char *p = input.data();
+  const char *end = p + input.size();
 
-  int buffer = 0;
+  uint64_t buffer = 0;
   int bitsLeft = 0;
-  for (char c : base32String) {
-    if (c == '=' || c == '\0')
+  uint8_t values[16];
+
+  while (p < end) {
+    // Fast path: on a byte boundary, 16 alphabet characters become 10 bytes.
+    if (bitsLeft == 0 && end - p >= 16 && translate16(p, values)) {
+      packBlock(values, out);
+      packBlock(values + 8, out + 5);
+      out += 10;
+      p += 16;
+      continue;
+    }
+
+    int8_t val = base32Lookup[static_cast<unsigned char>(*p++)];
+    if (val == END) {
       break;
-    int val = base32Lookup[static_cast<unsigned char>(toupper(c))];
-    if (val == -1)
+    }
+    if (val == SKIP) {
       continue;
-    buffer <<= 5;
-    buffer |= val & 0x1F;
+    }
+    buffer = (buffer << 5) | static_cast<uint64_t>(val);
     bitsLeft += 5;
     if (bitsLeft >= 8) {
-      result.push_back(static_cast<uint8_t>((buffer >> (bitsLeft - 8)) & 0xFF));
       bitsLeft -= 8;
+      *out++ = static_cast<uint8_t>(buffer >> bitsLeft);
+      buffer &= (1u << bitsLeft) - 1;
     }
   }
 
+  return static_cast<size_t>(out - start);
+}
+
+// Implement the encode function
+std::string encode(const std::vector<uint8_t> &data) {
+  std::string result(encodedSize(data.size(), true), '\0');
+  result.resize(encode(data.data(), data.size(), result.data(), true));
+  return result;
+}
+
+// Implement the decode function
+std::vector<uint8_t> decode(const std::string &base32String) {
+  std::vector<uint8_t> result(maxDecodedSize(base32String.size()));
+  result.resize(decode(std::string_view(base32String), result.data()));
   return result;
 }
 
@@ -98,15 +205,12 @@ std::string clean(const std::string &input) {
   output.reserve(input.size());
 
   for (char ch : input) {
-    // Convert character to uppercase safely
-    unsigned char uchar = static_cast<unsigned char>(ch);
-    char upperCh = static_cast<char>(std::toupper(uchar));
-
-    // Check if the character is a valid Base32 character
-    if (base32Chars.find(upperCh) != std::string::npos) {
-      output.push_back(upperCh);
+    // Keep alphabet characters (uppercased); drop padding '=' and anything
+    // invalid
+    int8_t val = base32Lookup[static_cast<unsigned char>(ch)];
+    if (val >= 0) {
+      output.push_back(base32Chars[val]);
     }
-    // Ignore padding characters '=' and any invalid characters
   }
 
   return output;
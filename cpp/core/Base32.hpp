@@ -1,10 +1,29 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace Base32 {
 
+// Output sizes, so callers can pre-size buffers for the pointer overloads.
+constexpr size_t encodedSize(size_t bytes, bool padding) {
+  return padding ? (bytes + 4) / 5 * 8 : (bytes * 8 + 4) / 5;
+}
+constexpr size_t maxDecodedSize(size_t chars) { return chars * 5 / 8; }
+
+// Writes the Base32 encoding of `data` to `out`, which must hold
+// encodedSize(size, padding) characters. Returns the number written.
+size_t encode(const uint8_t *data, size_t size, char *out, bool padding);
+
+// Decodes `input` into `out`, which must hold maxDecodedSize(input.size())
+// bytes. Decoding is case-insensitive, stops at the first '=' or NUL and
+// skips characters outside the alphabet (spaces, dashes). Returns the number
+// of bytes written.
+size_t decode(std::string_view input, uint8_t *out);
+
 std::string encode(const std::vector<uint8_t> &data);
 std::vector<uint8_t> decode(const std::string &base32String);
 std::string clean(const std::string &input);
@@ -0,0 +1,49 @@
+#include "Base64.hpp"
+#include <array>
+
+namespace Base64 {
+
+static constexpr int8_t INVALID = -1;
+
+static constexpr std::array<int8_t, 256> makeDecodeTable() {
+  std::array<int8_t, 256> table{};
+  for (auto &value : table) {
+    value = INVALID;
+  }
+  constexpr char chars[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  for (int i = 0; i < 64; ++i) {
+    table[static_cast<unsigned char>(chars[i])] = static_cast<int8_t>(i);
+  }
+  table[static_cast<unsigned char>('-')] = 62;
+  table[static_cast<unsigned char>('_')] = 63;
+  return table;
+}
+
+static constexpr std::array<int8_t, 256> base64Lookup = makeDecodeTable();
+
+bool decode(std::string_view input, uint8_t *out, size_t &size) {
+  while (!input.empty() && input.back() == '=') {
+    input.remove_suffix(1);
+  }
+
+  size = 0;
+  uint32_t buffer = 0;
+  int bits = 0;
+  for (char c : input) {
+    int8_t value = base64Lookup[static_cast<unsigned char>(c)];
+    if (value == INVALID) {
+      return false;
+    }
+    buffer = (buffer << 6) | static_cast<uint32_t>(value);
+    bits += 6;
+    if (bits >= 8) {
+      bits -= 8;
+      out[size++] = static_cast<uint8_t>(buffer >> bits);
+    }
+  }
+  // A single leftover sextet cannot come from a whole byte.
+  return bits < 6;
+}
+
+} // namespace Base64
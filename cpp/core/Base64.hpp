@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Base64 {
+
+constexpr size_t maxDecodedSize(size_t chars) { return chars / 4 * 3 + 2; }
+
+// Decodes `input` into `out`, which must hold maxDecodedSize(input.size())
+// bytes. Accepts the standard and the URL-safe alphabet, with or without
+// '=' padding. Returns false for any other character or a dangling sextet;
+// `size` is the number of bytes written.
+bool decode(std::string_view input, uint8_t *out, size_t &size);
+
+} // namespace Base64
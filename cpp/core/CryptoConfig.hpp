@@ -0,0 +1,20 @@
+#pragma once
+
+// Compile-time selection of the crypto primitives behind the OTP engine.
+
+// Set to 0 to build without OpenSSL. HMAC::compute then runs on the native
+// HMAC engine and random bytes come from the operating system's CSPRNG.
+#ifndef NITRO_TOTP_OPENSSL
+#define NITRO_TOTP_OPENSSL 1
+#endif
+
+// Selects the engine behind HMAC::Key. The native engine keeps precomputed
+// ipad/opad hash states and never enters the OpenSSL provider layer; set to 0
+// to route HMAC::Key through EVP_MAC instead.
+#ifndef NITRO_TOTP_NATIVE_HMAC
+#define NITRO_TOTP_NATIVE_HMAC 1
+#endif
+
+#if !NITRO_TOTP_OPENSSL && !NITRO_TOTP_NATIVE_HMAC
+#error "NITRO_TOTP_NATIVE_HMAC=0 requires NITRO_TOTP_OPENSSL=1"
+#endif
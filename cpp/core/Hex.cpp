@@ -0,0 +1,187 @@
+#include "Hex.hpp"
+#include <array>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define NITRO_TOTP_HEX_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define NITRO_TOTP_HEX_NEON 1
+#endif
+
+namespace Hex {
+
+static constexpr char hexChars[] = "0123456789ABCDEF";
+
+// Hex decoding table: 0-15 for hex digits (either case), INVALID otherwise.
+static constexpr uint8_t INVALID = 0xFF;
+
+static constexpr std::array<uint8_t, 256> makeDecodeTable() {
+  std::array<uint8_t, 256> table{};
+  for (auto &value : table) {
+    value = INVALID;
+  }
+  for (int i = 0; i < 16; ++i) {
+    unsigned char c = static_cast<unsigned char>(hexChars[i]);
+    table[c] = static_cast<uint8_t>(i);
+    if (c >= 'A' && c <= 'F') {
+      table[c - 'A' + 'a'] = static_cast<uint8_t>(i);
+    }
+  }
+  return table;
+}
+
+static constexpr std::array<uint8_t, 256> hexLookup = makeDecodeTable();
+
+// Encodes 16 bytes into 32 characters.
+static inline void encode16(const uint8_t *data, char *out) {
+#if NITRO_TOTP_HEX_SSE2
+  const __m128i bytes =
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+  const __m128i mask = _mm_set1_epi8(0x0F);
+  const __m128i high = _mm_and_si128(_mm_srli_epi16(bytes, 4), mask);
+  const __m128i low = _mm_and_si128(bytes, mask);
+  // '0' + n, plus 7 more for n >= 10 to land on 'A'.
+  auto toChars = [](__m128i n) {
+    const __m128i letter = _mm_cmpgt_epi8(n, _mm_set1_epi8(9));
+    return _mm_add_epi8(_mm_add_epi8(n, _mm_set1_epi8('0')),
+                        _mm_and_si128(letter, _mm_set1_epi8(7)));
+  };
+  const __m128i highChars = toChars(high);
+  const __m128i lowChars = toChars(low);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out),
+                   _mm_unpacklo_epi8(highChars, lowChars));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 16),
+                   _mm_unpackhi_epi8(highChars, lowChars));
+#elif NITRO_TOTP_HEX_NEON
+  const uint8x16_t table =
+      vld1q_u8(reinterpret_cast<const uint8_t *>(hexChars));
+  const uint8x16_t bytes = vld1q_u8(data);
+  uint8x16x2_t chars;
+  chars.val[0] = vqtbl1q_u8(table, vshrq_n_u8(bytes, 4));
+  chars.val[1] = vqtbl1q_u8(table, vandq_u8(bytes, vdupq_n_u8(0x0F)));
+  vst2q_u8(reinterpret_cast<uint8_t *>(out), chars);
+#else
+  for (int i = 0; i < 16; ++i) {
+    out[2 * i] = hexChars[data[i] >> 4];
+    out[2 * i + 1] = hexChars[data[i] & 15];
+  }
+#endif
+}
+
+// Decodes 32 characters into 16 bytes. Returns false if any of them is not a
+// hex digit.
+static inline bool decode32(const char *input, uint8_t *out) {
+#if NITRO_TOTP_HEX_SSE2
+  // Signed compares: bytes >= 0x80 are negative and fail every range check.
+  auto inRange = [](__m128i x, char lo, char hi) {
+    return _mm_and_si128(_mm_cmpgt_epi8(x, _mm_set1_epi8(lo - 1)),
+                         _mm_cmplt_epi8(x, _mm_set1_epi8(hi + 1)));
+  };
+  // Translates 16 characters to nibbles; `valid` collects failures.
+  auto translate = [&inRange](__m128i c, __m128i &valid) {
+    const __m128i isDigit = inRange(c, '0', '9');
+    const __m128i lower = _mm_or_si128(c, _mm_set1_epi8(0x20));
+    const __m128i isAlpha = inRange(lower, 'a', 'f');
+    valid = _mm_and_si128(valid, _mm_or_si128(isDigit, isAlpha));
+    const __m128i digit =
+        _mm_and_si128(isDigit, _mm_sub_epi8(c, _mm_set1_epi8('0')));
+    const __m128i alpha =
+        _mm_and_si128(isAlpha, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10)));
+    return _mm_or_si128(digit, alpha);
+  };
+  // Each 16-bit lane holds one (high, low) nibble pair; fold it into a byte
+  // and pack the two halves together.
+  auto combine = [](__m128i nibbles) {
+    const __m128i high =
+        _mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00FF)), 4);
+    const __m128i low = _mm_srli_epi16(nibbles, 8);
+    return _mm_or_si128(high, low);
+  };
+
+  __m128i valid = _mm_set1_epi8(-1);
+  const __m128i first = translate(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(input)), valid);
+  const __m128i second = translate(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + 16)), valid);
+  if (_mm_movemask_epi8(valid) != 0xFFFF) {
+    return false;
+  }
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out),
+                   _mm_packus_epi16(combine(first), combine(second)));
+  return true;
+#elif NITRO_TOTP_HEX_NEON
+  auto inRange = [](uint8x16_t x, uint8_t lo, uint8_t hi) {
+    return vandq_u8(vcgeq_u8(x, vdupq_n_u8(lo)), vcleq_u8(x, vdupq_n_u8(hi)));
+  };
+  auto translate = [&inRange](uint8x16_t c, uint8x16_t &valid) {
+    const uint8x16_t isDigit = inRange(c, '0', '9');
+    const uint8x16_t lower = vorrq_u8(c, vdupq_n_u8(0x20));
+    const uint8x16_t isAlpha = inRange(lower, 'a', 'f');
+    valid = vandq_u8(valid, vorrq_u8(isDigit, isAlpha));
+    const uint8x16_t digit = vandq_u8(isDigit, vsubq_u8(c, vdupq_n_u8('0')));
+    const uint8x16_t alpha =
+        vandq_u8(isAlpha, vsubq_u8(lower, vdupq_n_u8('a' - 10)));
+    return vorrq_u8(digit, alpha);
+  };
+
+  // De-interleaves high and low nibble characters.
+  const uint8x16x2_t chars =
+      vld2q_u8(reinterpret_cast<const uint8_t *>(input));
+  uint8x16_t valid = vdupq_n_u8(0xFF);
+  const uint8x16_t high = translate(chars.val[0], valid);
+  const uint8x16_t low = translate(chars.val[1], valid);
+  if (vminvq_u8(valid) != 0xFF) {
+    return false;
+  }
+  vst1q_u8(out, vorrq_u8(vshlq_n_u8(high, 4), low));
+  return true;
+#else
+  for (int i = 0; i < 16; ++i) {
+    uint8_t high = hexLookup[static_cast<unsigned char>(input[2 * i])];
+    uint8_t low = hexLookup[static_cast<unsigned char>(input[2 * i + 1])];
+    if (high == INVALID || low == INVALID) {
+      return false;
+    }
+    out[i] = static_cast<uint8_t>(high << 4 | low);
+  }
+  return true;
+#endif
+}
+
+void encode(const uint8_t *data, size_t size, char *out) {
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    encode16(data + i, out + 2 * i);
+  }
+  for (; i < size; ++i) {
+    out[2 * i] = hexChars[data[i] >> 4];
+    out[2 * i + 1] = hexChars[data[i] & 15];
+  }
+}
+
+Status decode(std::string_view input, uint8_t *out) {
+  if (input.size() % 2 != 0) {
+    return Status::ODD_LENGTH;
+  }
+
+  const char *p = input.data();
+  size_t size = decodedSize(input.size());
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    if (!decode32(p + 2 * i, out + i)) {
+      return Status::INVALID_CHARACTER;
+    }
+  }
+  for (; i < size; ++i) {
+    uint8_t high = hexLookup[static_cast<unsigned char>(p[2 * i])];
+    uint8_t low = hexLookup[static_cast<unsigned char>(p[2 * i + 1])];
+    if (high == INVALID || low == INVALID) {
+      return Status::INVALID_CHARACTER;
+    }
+    out[i] = static_cast<uint8_t>(high << 4 | low);
+  }
+  return Status::OK;
+}
+
+} // namespace Hex
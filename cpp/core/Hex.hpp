@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Hex {
+
+constexpr size_t encodedSize(size_t bytes) { return bytes * 2; }
+constexpr size_t decodedSize(size_t chars) { return chars / 2; }
+
+enum class Status : uint8_t {
+  OK,
+  // The input has an odd number of characters.
+  ODD_LENGTH,
+  // The input contains a character other than 0-9, a-f and A-F.
+  INVALID_CHARACTER,
+};
+
+// Writes the uppercase hex encoding of `data` to `out`, which must hold
+// encodedSize(size) characters.
+void encode(const uint8_t *data, size_t size, char *out);
+
+// Decodes `input` (either case) into `out`, which must hold
+// decodedSize(input.size()) bytes. Nothing is skipped: any character outside
+// the alphabet is an error. On error the contents of `out` are unspecified.
+Status decode(std::string_view input, uint8_t *out);
+
+} // namespace Hex
@@ -1,40 +1,72 @@
 #include "Hmac.hpp"
+#include "SecureMemory.hpp"
+#include "Sha.hpp"
 #include <cstring>
+#include <stdexcept>
+
+#if NITRO_TOTP_OPENSSL
 #include <openssl/core_names.h>
 #include <openssl/evp.h>
-#include <stdexcept>
+#endif
 
 namespace HMAC {
 
-std::vector<uint8_t> compute(const std::string &algorithm,
-                             const std::vector<uint8_t> &key,
-                             const std::vector<uint8_t> &data) {
-  EVP_MAC *mac = nullptr;
-  EVP_MAC_CTX *ctx = nullptr;
-  OSSL_PARAM params[2];
-  size_t params_n = 0;
-  const char *mac_name = "HMAC";
-  const char *digest_name = nullptr;
+Algorithm getAlgorithm(const std::string &name) {
+  if (name == "SHA1") {
+    return Algorithm::SHA1;
+  } else if (name == "SHA256") {
+    return Algorithm::SHA256;
+  } else if (name == "SHA512") {
+    return Algorithm::SHA512;
+  }
+  throw std::runtime_error("Unsupported algorithm");
+}
 
+size_t getDigestSize(Algorithm algorithm) {
+  switch (algorithm) {
+  case Algorithm::SHA1:
+    return SHA::Sha1::DIGEST_SIZE;
+  case Algorithm::SHA256:
+    return SHA::Sha256::DIGEST_SIZE;
+  case Algorithm::SHA512:
+    return SHA::Sha512::DIGEST_SIZE;
+  }
+  throw std::runtime_error("Unsupported algorithm");
+}
+
+#if NITRO_TOTP_OPENSSL
+
+static const char *getDigestName(Algorithm algorithm) {
   // Map algorithm to digest name
-  if (algorithm == "SHA1") {
-    digest_name = "SHA1";
-  } else if (algorithm == "SHA256") {
-    digest_name = "SHA256";
-  } else if (algorithm == "SHA512") {
-    digest_name = "SHA512";
-  } else {
-    throw std::runtime_error("Unsupported algorithm");
+  switch (algorithm) {
+  case Algorithm::SHA1:
+    return "SHA1";
+  case Algorithm::SHA256:
+    return "SHA256";
+  case Algorithm::SHA512:
+    return "SHA512";
   }
+  throw std::runtime_error("Unsupported algorithm");
+}
 
-  mac = EVP_MAC_fetch(nullptr, mac_name, nullptr);
+// Fetch the HMAC implementation once; EVP_MAC_fetch does a provider lookup
+// and is far more expensive than the MAC itself for short messages.
+static EVP_MAC *fetchMac() {
+  static EVP_MAC *mac = EVP_MAC_fetch(nullptr, "HMAC", nullptr);
   if (!mac) {
     throw std::runtime_error("Failed to fetch HMAC");
   }
+  return mac;
+}
+
+static EVP_MAC_CTX *createContext(Algorithm algorithm, const uint8_t *key,
+                                  size_t size) {
+  OSSL_PARAM params[2];
+  size_t params_n = 0;
+  const char *digest_name = getDigestName(algorithm);
 
   // Create MAC context
-  ctx = EVP_MAC_CTX_new(mac);
-  EVP_MAC_free(mac);
+  EVP_MAC_CTX *ctx = EVP_MAC_CTX_new(fetchMac());
   if (!ctx) {
     throw std::runtime_error("Failed to create HMAC context");
   }
@@ -45,34 +77,223 @@ std::vector<uint8_t> compute(const std::string &algorithm,
   params[params_n] = OSSL_PARAM_construct_end();
 
   // Initialize MAC context
-  if (EVP_MAC_init(ctx, key.data(), key.size(), params) != 1) {
+  if (EVP_MAC_init(ctx, key, size, params) != 1) {
     EVP_MAC_CTX_free(ctx);
     throw std::runtime_error("Failed to initialize HMAC");
   }
 
+  return ctx;
+}
+
+// Consumes `ctx`.
+static void finalize(EVP_MAC_CTX *ctx, const uint8_t *data, size_t size,
+                     uint8_t *out, size_t *outSize, size_t capacity) {
   // Update MAC context with data
-  if (EVP_MAC_update(ctx, data.data(), data.size()) != 1) {
+  if (EVP_MAC_update(ctx, data, size) != 1) {
     EVP_MAC_CTX_free(ctx);
     throw std::runtime_error("Failed to update HMAC");
   }
 
-  // Finalize MAC and get the output size
-  size_t out_len = 0;
-  if (EVP_MAC_final(ctx, nullptr, &out_len, 0) != 1) {
-    EVP_MAC_CTX_free(ctx);
-    throw std::runtime_error("Failed to finalize HMAC");
-  }
-
   // Get the MAC output
-  std::vector<uint8_t> hmacResult(out_len);
-  if (EVP_MAC_final(ctx, hmacResult.data(), &out_len, hmacResult.size()) != 1) {
+  if (EVP_MAC_final(ctx, out, outSize, capacity) != 1) {
     EVP_MAC_CTX_free(ctx);
     throw std::runtime_error("Failed to get HMAC result");
   }
 
   EVP_MAC_CTX_free(ctx);
+}
+
+std::vector<uint8_t> compute(const std::string &algorithm,
+                             const std::vector<uint8_t> &key,
+                             const std::vector<uint8_t> &data) {
+  EVP_MAC_CTX *ctx = createContext(getAlgorithm(algorithm), key.data(),
+                                   key.size());
+  std::vector<uint8_t> hmacResult(EVP_MAX_MD_SIZE);
+  size_t out_len = 0;
+  finalize(ctx, data.data(), data.size(), hmacResult.data(), &out_len,
+           hmacResult.size());
   hmacResult.resize(out_len);
   return hmacResult;
 }
 
+#else
+
+std::vector<uint8_t> compute(const std::string &algorithm,
+                             const std::vector<uint8_t> &key,
+                             const std::vector<uint8_t> &data) {
+  return Key(getAlgorithm(algorithm), key.data(), key.size())
+      .compute(data.data(), data.size());
+}
+
+#endif
+
+Key::Key(const std::string &algorithm, const std::vector<uint8_t> &key)
+    : Key(HMAC::getAlgorithm(algorithm), key.data(), key.size()) {}
+
+std::vector<uint8_t> Key::compute(const uint8_t *data, size_t size) const {
+  Digest digest;
+  compute(data, size, digest);
+  return std::vector<uint8_t>(digest.bytes.begin(),
+                              digest.bytes.begin() + digest.size);
+}
+
+#if NITRO_TOTP_NATIVE_HMAC
+
+template <typename H> static typename H::Word *words(void *state) {
+  return static_cast<typename H::Word *>(state);
+}
+
+template <typename H> static const typename H::Word *words(const void *state) {
+  return static_cast<const typename H::Word *>(state);
+}
+
+template <typename H> void Key::init(const uint8_t *key, size_t size) {
+  uint8_t block[H::BLOCK_SIZE] = {};
+  if (size > H::BLOCK_SIZE) {
+    SHA::hash<H>(key, size, block);
+  } else {
+    std::memcpy(block, key, size);
+  }
+
+  for (size_t i = 0; i < H::BLOCK_SIZE; ++i) {
+    block[i] ^= 0x36;
+  }
+  typename H::Word *in = words<H>(&inner);
+  H::init(in);
+  H::compress(in, block);
+
+  // 0x36 ^ 0x5c flips the ipad block into the opad block.
+  for (size_t i = 0; i < H::BLOCK_SIZE; ++i) {
+    block[i] ^= 0x36 ^ 0x5c;
+  }
+  typename H::Word *out = words<H>(&outer);
+  H::init(out);
+  H::compress(out, block);
+
+  SecureMemory::wipe(block, sizeof(block));
+}
+
+template <typename H>
+void Key::sign(const uint8_t *data, size_t size, Digest &out) const {
+  typename H::Word state[H::STATE_WORDS];
+  uint8_t innerDigest[H::DIGEST_SIZE];
+
+  std::memcpy(state, words<H>(&inner), sizeof(state));
+  SHA::finish<H>(state, data, size, H::BLOCK_SIZE, innerDigest);
+
+  std::memcpy(state, words<H>(&outer), sizeof(state));
+  SHA::finish<H>(state, innerDigest, H::DIGEST_SIZE, H::BLOCK_SIZE,
+                 out.bytes.data());
+  out.size = H::DIGEST_SIZE;
+}
+
+// Both hash passes fit in a single pre-padded block: the 8-byte counter for
+// the inner hash and the inner digest for the outer one. That is exactly two
+// compression calls per OTP with no buffering or length bookkeeping.
+template <typename H>
+void Key::signCounter(uint64_t counter, Digest &out) const {
+  typename H::Word state[H::STATE_WORDS];
+  uint8_t block[H::BLOCK_SIZE] = {};
+
+  for (int i = 7; i >= 0; --i) {
+    block[i] = static_cast<uint8_t>(counter & 0xFF);
+    counter >>= 8;
+  }
+  block[8] = 0x80;
+  uint64_t bits = (H::BLOCK_SIZE + 8) * 8;
+  for (int i = 0; i < 8; ++i) {
+    block[H::BLOCK_SIZE - 1 - i] = static_cast<uint8_t>(bits >> (8 * i));
+  }
+  std::memcpy(state, words<H>(&inner), sizeof(state));
+  H::compress(state, block);
+
+  std::memset(block, 0, sizeof(block));
+  SHA::storeDigest<H>(state, block);
+  block[H::DIGEST_SIZE] = 0x80;
+  bits = (H::BLOCK_SIZE + H::DIGEST_SIZE) * 8;
+  for (int i = 0; i < 8; ++i) {
+    block[H::BLOCK_SIZE - 1 - i] = static_cast<uint8_t>(bits >> (8 * i));
+  }
+  std::memcpy(state, words<H>(&outer), sizeof(state));
+  H::compress(state, block);
+
+  SHA::storeDigest<H>(state, out.bytes.data());
+  out.size = H::DIGEST_SIZE;
+}
+
+Key::Key(Algorithm algorithm, const uint8_t *key, size_t size)
+    : algorithm(algorithm) {
+  if (size == 0) {
+    throw std::runtime_error("Failed to initialize HMAC");
+  }
+
+  switch (algorithm) {
+  case Algorithm::SHA1:
+    init<SHA::Sha1>(key, size);
+    return;
+  case Algorithm::SHA256:
+    init<SHA::Sha256>(key, size);
+    return;
+  case Algorithm::SHA512:
+    init<SHA::Sha512>(key, size);
+    return;
+  }
+  throw std::runtime_error("Unsupported algorithm");
+}
+
+Key::~Key() {
+  SecureMemory::wipe(&inner, sizeof(inner));
+  SecureMemory::wipe(&outer, sizeof(outer));
+}
+
+void Key::computeCounter(uint64_t counter, Digest &out) const {
+  switch (algorithm) {
+  case Algorithm::SHA1:
+    return signCounter<SHA::Sha1>(counter, out);
+  case Algorithm::SHA256:
+    return signCounter<SHA::Sha256>(counter, out);
+  case Algorithm::SHA512:
+    return signCounter<SHA::Sha512>(counter, out);
+  }
+}
+
+void Key::compute(const uint8_t *data, size_t size, Digest &out) const {
+  switch (algorithm) {
+  case Algorithm::SHA1:
+    return sign<SHA::Sha1>(data, size, out);
+  case Algorithm::SHA256:
+    return sign<SHA::Sha256>(data, size, out);
+  case Algorithm::SHA512:
+    return sign<SHA::Sha512>(data, size, out);
+  }
+}
+
+#else
+
+Key::Key(Algorithm algorithm, const uint8_t *key, size_t size)
+    : algorithm(algorithm), ctx(createContext(algorithm, key, size)) {}
+
+Key::~Key() { EVP_MAC_CTX_free(ctx); }
+
+void Key::computeCounter(uint64_t counter, Digest &out) const {
+  uint8_t data[8];
+  for (int i = 7; i >= 0; --i) {
+    data[i] = static_cast<uint8_t>(counter & 0xFF);
+    counter >>= 8;
+  }
+  compute(data, sizeof(data), out);
+}
+
+void Key::compute(const uint8_t *data, size_t size, Digest &out) const {
+  // Duplicating the initialized context copies the ipad/opad digest states
+  // instead of re-running the key schedule.
+  EVP_MAC_CTX *copy = EVP_MAC_CTX_dup(ctx);
+  if (!copy) {
+    throw std::runtime_error("Failed to duplicate HMAC context");
+  }
+  finalize(copy, data, size, out.bytes.data(), &out.size, out.bytes.size());
+}
+
+#endif
+
 } // namespace HMAC
@@ -1,12 +1,87 @@
 #pragma once
 
+#include "CryptoConfig.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
+struct evp_mac_ctx_st;
+
 namespace HMAC {
 
+enum class Algorithm : uint8_t { SHA1, SHA256, SHA512 };
+
+Algorithm getAlgorithm(const std::string &name);
+size_t getDigestSize(Algorithm algorithm);
+
+// Fixed-capacity MAC output, large enough for HMAC-SHA512.
+struct Digest {
+  std::array<uint8_t, 64> bytes;
+  size_t size = 0;
+};
+
+// One-shot HMAC of an arbitrary message. Uses OpenSSL's EVP_MAC as the
+// reference implementation, or the native engine without OpenSSL.
 std::vector<uint8_t> compute(const std::string &algorithm,
                              const std::vector<uint8_t> &key,
                              const std::vector<uint8_t> &data);
 
+class Key;
+
+// Counter MACs for `count` independent (key, counter) pairs. With the native
+// engine, SHA-1 and SHA-256 keys are hashed several lanes at a time using
+// SIMD (SSE2 or NEON, or AVX2 when the host build enables NITRO_TOTP_AVX2);
+// everything else goes through Key::computeCounter one at a time.
+void computeCounters(const Key *const *keys, const uint64_t *counters,
+                     size_t count, Digest *out);
+
+// Number of messages the multi-buffer kernel hashes per compression call.
+size_t getLaneCount();
+
+// Keyed HMAC context. The key schedule runs once in the constructor; every
+// compute() starts from the prepared state, so the same Key can be reused for
+// any number of messages.
+class Key {
+public:
+  Key(Algorithm algorithm, const uint8_t *key, size_t size);
+  Key(const std::string &algorithm, const std::vector<uint8_t> &key);
+  ~Key();
+
+  Key(const Key &) = delete;
+  Key &operator=(const Key &) = delete;
+
+  Algorithm getAlgorithm() const { return algorithm; }
+
+  // MAC of the 8-byte big-endian counter used by HOTP/TOTP.
+  void computeCounter(uint64_t counter, Digest &out) const;
+
+  void compute(const uint8_t *data, size_t size, Digest &out) const;
+  std::vector<uint8_t> compute(const uint8_t *data, size_t size) const;
+
+private:
+  friend void computeCounters(const Key *const *keys, const uint64_t *counters,
+                              size_t count, Digest *out);
+
+  Algorithm algorithm;
+#if NITRO_TOTP_NATIVE_HMAC
+  // Hash states after absorbing key ^ ipad and key ^ opad. Only the member
+  // matching the algorithm's word size is used.
+  union State {
+    uint32_t w32[8];
+    uint64_t w64[8];
+  };
+  State inner;
+  State outer;
+
+  template <typename H> void init(const uint8_t *key, size_t size);
+  template <typename H>
+  void sign(const uint8_t *data, size_t size, Digest &out) const;
+  template <typename H> void signCounter(uint64_t counter, Digest &out) const;
+#else
+  evp_mac_ctx_st *ctx;
+#endif
+};
+
 } // namespace HMAC
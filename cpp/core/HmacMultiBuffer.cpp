@@ -0,0 +1,348 @@
+#include "Hmac.hpp"
+#include "Sha.hpp"
+
+#if NITRO_TOTP_NATIVE_HMAC
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+#endif
+
+namespace HMAC {
+
+#if NITRO_TOTP_NATIVE_HMAC
+
+// Lane abstraction: one vector register holds the same 32-bit state word of
+// several independent messages. Rotations are built from shifts so that the
+// round functions below are written once for every instruction set.
+// The AVX2 lanes are only compiled in when this file is built with AVX2
+// enabled, which the host build does for NITRO_TOTP_AVX2; app builds target
+// baseline CPUs and use SSE2 or NEON.
+#if defined(__AVX2__)
+
+struct Lanes {
+  using T = __m256i;
+  static constexpr size_t COUNT = 8;
+
+  static T set1(uint32_t x) { return _mm256_set1_epi32(static_cast<int>(x)); }
+  static T load(const uint32_t *p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+  }
+  static void store(uint32_t *p, T x) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), x);
+  }
+  static T add(T a, T b) { return _mm256_add_epi32(a, b); }
+  static T bxor(T a, T b) { return _mm256_xor_si256(a, b); }
+  static T band(T a, T b) { return _mm256_and_si256(a, b); }
+  static T bor(T a, T b) { return _mm256_or_si256(a, b); }
+  // ~a & b
+  static T andnot(T a, T b) { return _mm256_andnot_si256(a, b); }
+  template <int N> static T shl(T a) { return _mm256_slli_epi32(a, N); }
+  template <int N> static T shr(T a) { return _mm256_srli_epi32(a, N); }
+};
+
+#elif defined(__SSE2__) || defined(_M_X64)
+
+struct Lanes {
+  using T = __m128i;
+  static constexpr size_t COUNT = 4;
+
+  static T set1(uint32_t x) { return _mm_set1_epi32(static_cast<int>(x)); }
+  static T load(const uint32_t *p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+  }
+  static void store(uint32_t *p, T x) {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(p), x);
+  }
+  static T add(T a, T b) { return _mm_add_epi32(a, b); }
+  static T bxor(T a, T b) { return _mm_xor_si128(a, b); }
+  static T band(T a, T b) { return _mm_and_si128(a, b); }
+  static T bor(T a, T b) { return _mm_or_si128(a, b); }
+  // ~a & b
+  static T andnot(T a, T b) { return _mm_andnot_si128(a, b); }
+  template <int N> static T shl(T a) { return _mm_slli_epi32(a, N); }
+  template <int N> static T shr(T a) { return _mm_srli_epi32(a, N); }
+};
+
+#elif defined(__ARM_NEON)
+
+struct Lanes {
+  using T = uint32x4_t;
+  static constexpr size_t COUNT = 4;
+
+  static T set1(uint32_t x) { return vdupq_n_u32(x); }
+  static T load(const uint32_t *p) { return vld1q_u32(p); }
+  static void store(uint32_t *p, T x) { vst1q_u32(p, x); }
+  static T add(T a, T b) { return vaddq_u32(a, b); }
+  static T bxor(T a, T b) { return veorq_u32(a, b); }
+  static T band(T a, T b) { return vandq_u32(a, b); }
+  static T bor(T a, T b) { return vorrq_u32(a, b); }
+  // ~a & b
+  static T andnot(T a, T b) { return vbicq_u32(b, a); }
+  template <int N> static T shl(T a) { return vshlq_n_u32(a, N); }
+  template <int N> static T shr(T a) { return vshrq_n_u32(a, N); }
+};
+
+#else
+
+// Portable fallback: a single lane, which still avoids the per-call
+// dispatch in Key::computeCounter.
+struct Lanes {
+  using T = uint32_t;
+  static constexpr size_t COUNT = 1;
+
+  static T set1(uint32_t x) { return x; }
+  static T load(const uint32_t *p) { return *p; }
+  static void store(uint32_t *p, T x) { *p = x; }
+  static T add(T a, T b) { return a + b; }
+  static T bxor(T a, T b) { return a ^ b; }
+  static T band(T a, T b) { return a & b; }
+  static T bor(T a, T b) { return a | b; }
+  // ~a & b
+  static T andnot(T a, T b) { return ~a & b; }
+  template <int N> static T shl(T a) { return a << N; }
+  template <int N> static T shr(T a) { return a >> N; }
+};
+
+#endif
+
+using V = Lanes::T;
+constexpr size_t LANES = Lanes::COUNT;
+
+template <int N> static inline V rotl(V x) {
+  return Lanes::bor(Lanes::shl<N>(x), Lanes::shr<32 - N>(x));
+}
+
+template <int N> static inline V rotr(V x) { return rotl<32 - N>(x); }
+
+static void sha1Compress(V *state, V *w) {
+  V a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+
+  // The message schedule is kept as a rolling 16-word window.
+  auto schedule = [w](int i) {
+    if (i >= 16) {
+      w[i & 15] = rotl<1>(
+          Lanes::bxor(Lanes::bxor(w[(i - 3) & 15], w[(i - 8) & 15]),
+                      Lanes::bxor(w[(i - 14) & 15], w[i & 15])));
+    }
+    return w[i & 15];
+  };
+  auto round = [&](V f, V k, V wi) {
+    V t = Lanes::add(Lanes::add(rotl<5>(a), f),
+                     Lanes::add(Lanes::add(e, k), wi));
+    e = d;
+    d = c;
+    c = rotl<30>(b);
+    b = a;
+    a = t;
+  };
+
+  int i = 0;
+  const V k0 = Lanes::set1(0x5A827999);
+  for (; i < 20; ++i)
+    round(Lanes::bor(Lanes::band(b, c), Lanes::andnot(b, d)), k0, schedule(i));
+  const V k1 = Lanes::set1(0x6ED9EBA1);
+  for (; i < 40; ++i)
+    round(Lanes::bxor(Lanes::bxor(b, c), d), k1, schedule(i));
+  const V k2 = Lanes::set1(0x8F1BBCDC);
+  for (; i < 60; ++i)
+    round(Lanes::bor(Lanes::band(b, c), Lanes::band(d, Lanes::bor(b, c))), k2,
+          schedule(i));
+  const V k3 = Lanes::set1(0xCA62C1D6);
+  for (; i < 80; ++i)
+    round(Lanes::bxor(Lanes::bxor(b, c), d), k3, schedule(i));
+
+  state[0] = Lanes::add(state[0], a);
+  state[1] = Lanes::add(state[1], b);
+  state[2] = Lanes::add(state[2], c);
+  state[3] = Lanes::add(state[3], d);
+  state[4] = Lanes::add(state[4], e);
+}
+
+static void sha256Compress(V *state, V *w) {
+  V a = state[0], b = state[1], c = state[2], d = state[3], e = state[4],
+    f = state[5], g = state[6], h = state[7];
+
+  for (int i = 0; i < 64; ++i) {
+    if (i >= 16) {
+      V w15 = w[(i - 15) & 15];
+      V w2 = w[(i - 2) & 15];
+      V s0 = Lanes::bxor(Lanes::bxor(rotr<7>(w15), rotr<18>(w15)),
+                         Lanes::shr<3>(w15));
+      V s1 = Lanes::bxor(Lanes::bxor(rotr<17>(w2), rotr<19>(w2)),
+                         Lanes::shr<10>(w2));
+      w[i & 15] = Lanes::add(Lanes::add(w[i & 15], s0),
+                             Lanes::add(w[(i - 7) & 15], s1));
+    }
+
+    V S1 = Lanes::bxor(Lanes::bxor(rotr<6>(e), rotr<11>(e)), rotr<25>(e));
+    V ch = Lanes::bxor(Lanes::band(e, f), Lanes::andnot(e, g));
+    V t1 = Lanes::add(
+        Lanes::add(h, S1),
+        Lanes::add(Lanes::add(ch, Lanes::set1(SHA::Sha256::ROUND_CONSTANTS[i])),
+                   w[i & 15]));
+    V S0 = Lanes::bxor(Lanes::bxor(rotr<2>(a), rotr<13>(a)), rotr<22>(a));
+    V maj = Lanes::bor(Lanes::band(a, b), Lanes::band(c, Lanes::bor(a, b)));
+    V t2 = Lanes::add(S0, maj);
+    h = g;
+    g = f;
+    f = e;
+    e = Lanes::add(d, t1);
+    d = c;
+    c = b;
+    b = a;
+    a = Lanes::add(t1, t2);
+  }
+
+  state[0] = Lanes::add(state[0], a);
+  state[1] = Lanes::add(state[1], b);
+  state[2] = Lanes::add(state[2], c);
+  state[3] = Lanes::add(state[3], d);
+  state[4] = Lanes::add(state[4], e);
+  state[5] = Lanes::add(state[5], f);
+  state[6] = Lanes::add(state[6], g);
+  state[7] = Lanes::add(state[7], h);
+}
+
+// Gathers word `word` of every lane's state into one vector.
+static V gather(const uint32_t *const *states, size_t word) {
+  alignas(32) uint32_t column[LANES];
+  for (size_t lane = 0; lane < LANES; ++lane) {
+    column[lane] = states[lane][word];
+  }
+  return Lanes::load(column);
+}
+
+// Runs the inner and outer compressions of HMAC(counter) for LANES keys at
+// once, starting from their precomputed ipad/opad states. As in
+// Key::signCounter, both messages fit in one pre-padded block, so the only
+// per-lane inputs are the counter words and the inner digest.
+template <typename H, void (*Compress)(V *, V *)>
+static void signCounters(const uint32_t *const *inner,
+                         const uint32_t *const *outer,
+                         const uint64_t *const *counters, Digest *const *out) {
+  constexpr size_t words = H::STATE_WORDS;
+  V state[words];
+  V w[16];
+
+  for (size_t j = 0; j < words; ++j) {
+    state[j] = gather(inner, j);
+  }
+  alignas(32) uint32_t hi[LANES], lo[LANES];
+  for (size_t lane = 0; lane < LANES; ++lane) {
+    hi[lane] = static_cast<uint32_t>(*counters[lane] >> 32);
+    lo[lane] = static_cast<uint32_t>(*counters[lane]);
+  }
+  w[0] = Lanes::load(hi);
+  w[1] = Lanes::load(lo);
+  w[2] = Lanes::set1(0x80000000);
+  for (size_t j = 3; j < 15; ++j) {
+    w[j] = Lanes::set1(0);
+  }
+  w[15] = Lanes::set1((H::BLOCK_SIZE + 8) * 8);
+  Compress(state, w);
+
+  for (size_t j = 0; j < words; ++j) {
+    w[j] = state[j];
+    state[j] = gather(outer, j);
+  }
+  w[words] = Lanes::set1(0x80000000);
+  for (size_t j = words + 1; j < 15; ++j) {
+    w[j] = Lanes::set1(0);
+  }
+  w[15] = Lanes::set1((H::BLOCK_SIZE + H::DIGEST_SIZE) * 8);
+  Compress(state, w);
+
+  alignas(32) uint32_t column[LANES];
+  uint32_t result[LANES][words];
+  for (size_t j = 0; j < words; ++j) {
+    Lanes::store(column, state[j]);
+    for (size_t lane = 0; lane < LANES; ++lane) {
+      result[lane][j] = column[lane];
+    }
+  }
+  for (size_t lane = 0; lane < LANES; ++lane) {
+    SHA::storeDigest<H>(result[lane], out[lane]->bytes.data());
+    out[lane]->size = H::DIGEST_SIZE;
+  }
+}
+
+// Collects keys of one algorithm until a full set of lanes is ready.
+template <typename H, void (*Compress)(V *, V *)> struct LaneGroup {
+  const uint32_t *inner[LANES];
+  const uint32_t *outer[LANES];
+  const uint64_t *counters[LANES];
+  Digest *out[LANES];
+  size_t size = 0;
+
+  void push(const uint32_t *in, const uint32_t *ou, const uint64_t *counter,
+            Digest *digest) {
+    inner[size] = in;
+    outer[size] = ou;
+    counters[size] = counter;
+    out[size] = digest;
+    if (++size == LANES) {
+      flush();
+    }
+  }
+
+  void flush() {
+    if (size == 0) {
+      return;
+    }
+    // Fill idle lanes with the last message and a scratch output.
+    Digest scratch;
+    for (size_t lane = size; lane < LANES; ++lane) {
+      inner[lane] = inner[size - 1];
+      outer[lane] = outer[size - 1];
+      counters[lane] = counters[size - 1];
+      out[lane] = &scratch;
+    }
+    signCounters<H, Compress>(inner, outer, counters, out);
+    size = 0;
+  }
+};
+
+void computeCounters(const Key *const *keys, const uint64_t *counters,
+                     size_t count, Digest *out) {
+  LaneGroup<SHA::Sha1, sha1Compress> sha1;
+  LaneGroup<SHA::Sha256, sha256Compress> sha256;
+
+  for (size_t i = 0; i < count; ++i) {
+    const Key &key = *keys[i];
+    switch (key.algorithm) {
+    case Algorithm::SHA1:
+      sha1.push(key.inner.w32, key.outer.w32, &counters[i], &out[i]);
+      break;
+    case Algorithm::SHA256:
+      sha256.push(key.inner.w32, key.outer.w32, &counters[i], &out[i]);
+      break;
+    default:
+      key.computeCounter(counters[i], out[i]);
+      break;
+    }
+  }
+
+  sha1.flush();
+  sha256.flush();
+}
+
+size_t getLaneCount() { return LANES; }
+
+#else
+
+void computeCounters(const Key *const *keys, const uint64_t *counters,
+                     size_t count, Digest *out) {
+  for (size_t i = 0; i < count; ++i) {
+    keys[i]->computeCounter(counters[i], out[i]);
+  }
+}
+
+size_t getLaneCount() { return 1; }
+
+#endif
+
+} // namespace HMAC
@@ -0,0 +1,226 @@
+#include "Hotp.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace HOTP {
+
+static void checkDigits(int digits) {
+  if (digits < MIN_DIGITS || digits > MAX_DIGITS) {
+    throw std::runtime_error("Digits must be between 1 and 10");
+  }
+}
+
+static void checkWindow(int window) {
+  if (window < 0 || window > MAX_WINDOW) {
+    throw std::runtime_error("Window must be between 0 and " +
+                             std::to_string(MAX_WINDOW));
+  }
+}
+
+void format(uint32_t otp, int digits, char *out) {
+  switch (digits) {
+  case 6:
+    return formatDigits<6>(otp, out);
+  case 7:
+    return formatDigits<7>(otp, out);
+  case 8:
+    return formatDigits<8>(otp, out);
+  default:
+    checkDigits(digits);
+    for (int i = digits - 1; i >= 0; --i) {
+      out[i] = static_cast<char>('0' + otp % 10);
+      otp /= 10;
+    }
+  }
+}
+
+uint32_t truncate(const HMAC::Digest &digest, int digits) {
+  int offset = digest.bytes[digest.size - 1] & 0x0F;
+  uint32_t binaryCode = ((digest.bytes[offset] & 0x7F) << 24) |
+                        ((digest.bytes[offset + 1] & 0xFF) << 16) |
+                        ((digest.bytes[offset + 2] & 0xFF) << 8) |
+                        (digest.bytes[offset + 3] & 0xFF);
+
+  checkDigits(digits);
+  return static_cast<uint32_t>(binaryCode % POWERS_OF_TEN[digits]);
+}
+
+uint32_t compute(const HMAC::Key &key, uint64_t counter, int digits) {
+  HMAC::Digest digest;
+  key.computeCounter(counter, digest);
+  return truncate(digest, digits);
+}
+
+void computeMany(const HMAC::Key *const *keys, const uint64_t *counters,
+                 size_t count, int digits, uint32_t *out) {
+  // Digests are produced in fixed-size chunks to keep them on the stack.
+  constexpr size_t CHUNK = 64;
+  HMAC::Digest digests[CHUNK];
+
+  for (size_t start = 0; start < count; start += CHUNK) {
+    size_t size = std::min(CHUNK, count - start);
+    HMAC::computeCounters(keys + start, counters + start, size, digests);
+    for (size_t i = 0; i < size; ++i) {
+      out[start + i] = truncate(digests[i], digits);
+    }
+  }
+}
+
+bool parse(const std::string &otp, int digits, uint32_t &out) {
+  if (digits <= 0 || otp.size() != static_cast<size_t>(digits)) {
+    return false;
+  }
+
+  uint64_t value = 0;
+  for (char c : otp) {
+    if (c < '0' || c > '9') {
+      return false;
+    }
+    value = value * 10 + static_cast<uint64_t>(c - '0');
+  }
+  if (value > UINT32_MAX) {
+    return false;
+  }
+
+  out = static_cast<uint32_t>(value);
+  return true;
+}
+
+std::optional<int> find(const HMAC::Key &key, uint64_t counter, int window,
+                        int digits, uint32_t otp) {
+  checkWindow(window);
+  std::optional<int> index =
+      find(key, counter, 0, 2 * window, digits, otp, nullptr);
+  if (!index) {
+    return std::nullopt;
+  }
+  return candidateOffset(*index);
+}
+
+std::optional<int> find(const HMAC::Key &key, uint64_t counter, int first,
+                        int last, int digits, uint32_t otp,
+                        const std::atomic<int> *bound) {
+  // Candidates are hashed in fixed-size chunks through the multi-buffer
+  // kernel, which shares one prepared key across all lanes.
+  constexpr int CHUNK = 64;
+  const HMAC::Key *keys[CHUNK];
+  uint64_t counters[CHUNK];
+  uint32_t codes[CHUNK];
+  std::fill(keys, keys + CHUNK, &key);
+
+  // 64-bit so that stepping past `last` cannot overflow.
+  for (int64_t start = first; start <= last; start += CHUNK) {
+    if (bound && start > bound->load(std::memory_order_relaxed)) {
+      break;
+    }
+    int size = static_cast<int>(std::min<int64_t>(CHUNK, last - start + 1));
+    for (int i = 0; i < size; ++i) {
+      counters[i] = counter + candidateOffset(start + i);
+    }
+    computeMany(keys, counters, size, digits, codes);
+    for (int i = 0; i < size; ++i) {
+      if (codes[i] == otp) {
+        return static_cast<int>(start + i);
+      }
+    }
+  }
+
+  return std::nullopt;
+}
+
+std::optional<int> findConstantTime(const HMAC::Key &key, uint64_t counter,
+                                    int window, int digits, uint32_t otp) {
+  checkWindow(window);
+  constexpr int CHUNK = 64;
+  const HMAC::Key *keys[CHUNK];
+  uint64_t counters[CHUNK];
+  uint32_t codes[CHUNK];
+  std::fill(keys, keys + CHUNK, &key);
+
+  // `first` is the lowest matching candidate index, or UINT32_MAX.
+  // Both reductions are plain loops over fixed arrays, which compilers turn
+  // into SIMD compares and min/or reductions.
+  const int64_t candidates = 2 * static_cast<int64_t>(window) + 1;
+  uint32_t first = UINT32_MAX;
+  uint32_t matched = 0;
+  for (int64_t start = 0; start < candidates; start += CHUNK) {
+    int size = static_cast<int>(std::min<int64_t>(CHUNK, candidates - start));
+    for (int i = 0; i < size; ++i) {
+      counters[i] = counter + candidateOffset(start + i);
+    }
+    computeMany(keys, counters, size, digits, codes);
+
+    for (int i = 0; i < size; ++i) {
+      // All ones when the codes are equal, zero otherwise.
+      uint32_t diff = codes[i] ^ otp;
+      uint32_t equal = static_cast<uint32_t>(
+          (static_cast<uint64_t>(diff) - 1) >> 32);
+      uint32_t index = static_cast<uint32_t>(start + i);
+      first = std::min(first, (index & equal) | ~equal);
+      matched |= equal;
+    }
+  }
+
+  if (!matched) {
+    return std::nullopt;
+  }
+  return candidateOffset(first);
+}
+
+void findMany(const HMAC::Key *const *keys, const uint32_t *otps,
+              size_t count, uint64_t counter, int window, int digits,
+              int32_t *deltas) {
+  checkDigits(digits);
+  checkWindow(window);
+  constexpr size_t CHUNK = 64;
+  const HMAC::Key *batchKeys[CHUNK];
+  uint64_t counters[CHUNK];
+  uint32_t codes[CHUNK];
+  // Entry and candidate index of each candidate in the batch.
+  size_t entries[CHUNK];
+  uint32_t indices[CHUNK];
+  size_t used = 0;
+
+  // Lowest matching candidate index per entry, or UINT32_MAX; reduced without
+  // data-dependent branches, as in findConstantTime().
+  std::vector<uint32_t> first(count, UINT32_MAX);
+  auto flush = [&]() {
+    computeMany(batchKeys, counters, used, digits, codes);
+    for (size_t i = 0; i < used; ++i) {
+      uint32_t diff = codes[i] ^ otps[entries[i]];
+      uint32_t equal = static_cast<uint32_t>(
+          (static_cast<uint64_t>(diff) - 1) >> 32);
+      first[entries[i]] =
+          std::min(first[entries[i]], (indices[i] & equal) | ~equal);
+    }
+    used = 0;
+  };
+
+  const uint32_t candidates = 2 * static_cast<uint32_t>(window) + 1;
+  for (size_t entry = 0; entry < count; ++entry) {
+    if (keys[entry] == nullptr) {
+      continue;
+    }
+    for (uint32_t index = 0; index < candidates; ++index) {
+      batchKeys[used] = keys[entry];
+      counters[used] = counter + candidateOffset(index);
+      entries[used] = entry;
+      indices[used] = index;
+      if (++used == CHUNK) {
+        flush();
+      }
+    }
+  }
+  if (used > 0) {
+    flush();
+  }
+
+  for (size_t entry = 0; entry < count; ++entry) {
+    deltas[entry] = first[entry] == UINT32_MAX
+                        ? NO_MATCH
+                        : candidateOffset(first[entry]);
+  }
+}
+
+} // namespace HOTP
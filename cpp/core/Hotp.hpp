@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Hmac.hpp"
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+// RFC 4226 HOTP on top of a prepared HMAC::Key. TOTP is HOTP with a
+// time-derived counter, so both hybrid objects share these helpers.
+namespace HOTP {
+
+// A 31-bit truncated HMAC has at most 10 decimal digits.
+constexpr int MIN_DIGITS = 1;
+constexpr int MAX_DIGITS = 10;
+
+// Largest accepted validation window. Far beyond any resync window, and
+// small enough that 2 * window + 1 candidates fit in an int.
+constexpr int MAX_WINDOW = 1 << 20;
+
+constexpr uint64_t POWERS_OF_TEN[MAX_DIGITS + 1] = {
+    1ULL,         10ULL,         100ULL,         1000ULL,
+    10000ULL,     100000ULL,     1000000ULL,     10000000ULL,
+    100000000ULL, 1000000000ULL, 10000000000ULL};
+
+// Writes `otp` as exactly `Digits` zero-padded decimal digits (no terminator).
+template <int Digits> inline void formatDigits(uint32_t otp, char *out) {
+  static_assert(Digits >= MIN_DIGITS && Digits <= MAX_DIGITS);
+  for (int i = Digits - 1; i >= 0; --i) {
+    out[i] = static_cast<char>('0' + otp % 10);
+    otp /= 10;
+  }
+}
+
+// Runtime-width variant of formatDigits; the common 6/7/8 widths dispatch to
+// fully unrolled instances. `out` must hold `digits` characters.
+void format(uint32_t otp, int digits, char *out);
+
+// Dynamic truncation of an HMAC result to a `digits`-long code.
+uint32_t truncate(const HMAC::Digest &digest, int digits);
+
+uint32_t compute(const HMAC::Key &key, uint64_t counter, int digits);
+
+// compute() over independent (key, counter) pairs, batched through the
+// multi-buffer HMAC kernel.
+void computeMany(const HMAC::Key *const *keys, const uint64_t *counters,
+                 size_t count, int digits, uint32_t *out);
+
+// Parses a submitted code of exactly `digits` decimal digits. Returns false
+// for anything else, which can never match a generated code.
+bool parse(const std::string &otp, int digits, uint32_t &out);
+
+// Offset from the center of the window of the index-th candidate a search
+// visits: 0, -1, 1, -2, 2, ... Searching in this order makes the first match
+// the one closest to the expected counter.
+inline int candidateOffset(int64_t index) {
+  return static_cast<int>(index % 2 != 0 ? -(index + 1) / 2 : index / 2);
+}
+
+// Searches counter - window .. counter + window for `otp` and returns the
+// offset of the matching counter closest to `counter`; of two equally close
+// matches, the earlier one. Throws if `window` is outside 0 .. MAX_WINDOW.
+std::optional<int> find(const HMAC::Key &key, uint64_t counter, int window,
+                        int digits, uint32_t otp);
+
+// Searches candidates first .. last in the order of candidateOffset() and
+// returns the index of the first match. When `bound` is given the search
+// stops once it passes *bound, so workers scanning later parts of a window
+// give up as soon as an earlier match is known.
+std::optional<int> find(const HMAC::Key &key, uint64_t counter, int first,
+                        int last, int digits, uint32_t otp,
+                        const std::atomic<int> *bound);
+
+// find() without early exit or data-dependent branches: every candidate in
+// the window is computed, compared with branch-free integer operations and
+// min-reduced, so the running time depends only on the window size. Returns
+// the same offset as find(), and throws for the same windows.
+std::optional<int> findConstantTime(const HMAC::Key &key, uint64_t counter,
+                                    int window, int digits, uint32_t otp);
+
+// findMany() result for entries without a match.
+constexpr int32_t NO_MATCH = INT32_MIN;
+
+// findConstantTime() over `count` (key, otp) pairs sharing `counter` and
+// `window`. Candidates of consecutive entries are packed into the same
+// multi-buffer batches, so keys of one algorithm should be adjacent.
+// deltas[i] receives find()'s offset for keys[i], or NO_MATCH; null keys
+// are skipped and always get NO_MATCH. Throws if `window` is outside
+// 0 .. MAX_WINDOW.
+void findMany(const HMAC::Key *const *keys, const uint32_t *otps,
+              size_t count, uint64_t counter, int window, int digits,
+              int32_t *deltas);
+
+} // namespace HOTP
@@ -0,0 +1,101 @@
+#include "KeyCache.hpp"
+#include "Base32.hpp"
+#include "SecureKey.hpp"
+#include "SecureMemory.hpp"
+#include <vector>
+
+KeyCache::KeyCache(size_t capacity) : capacity(capacity) {
+  stats.capacity = capacity;
+}
+
+KeyCache::~KeyCache() { clear(); }
+
+KeyCache &KeyCache::shared() {
+  // Intentionally leaked, like ThreadPool::shared(): pool workers may still
+  // look keys up while static destructors run at exit.
+  static KeyCache *cache = new KeyCache(64);
+  return *cache;
+}
+
+std::shared_ptr<const HMAC::Key>
+KeyCache::prepare(const std::string &secret, HMAC::Algorithm algorithm) {
+  // Secrets that fit a key slab slot are decoded on the stack; only longer
+  // ones need a heap buffer.
+  uint8_t stackBytes[SecureKey::CAPACITY];
+  std::vector<uint8_t> heapBytes;
+  size_t capacity = Base32::maxDecodedSize(secret.size());
+  uint8_t *bytes = stackBytes;
+  if (capacity > sizeof(stackBytes)) {
+    heapBytes.resize(capacity);
+    bytes = heapBytes.data();
+  }
+  size_t size = Base32::decode(secret, bytes);
+  try {
+    auto key = std::make_shared<const HMAC::Key>(algorithm, bytes, size);
+    SecureMemory::wipe(bytes, capacity);
+    return key;
+  } catch (...) {
+    SecureMemory::wipe(bytes, capacity);
+    throw;
+  }
+}
+
+std::shared_ptr<const HMAC::Key> KeyCache::get(const std::string &secret,
+                                               HMAC::Algorithm algorithm) {
+  size_t slot = static_cast<size_t>(algorithm);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(secret);
+    if (it != index.end() && it->second->keys[slot]) {
+      ++stats.hits;
+      entries.splice(entries.begin(), entries, it->second);
+      return it->second->keys[slot];
+    }
+    ++stats.misses;
+  }
+
+  // Decode and key outside the lock; a concurrent miss for the same secret
+  // just prepares the key twice.
+  std::shared_ptr<const HMAC::Key> key = prepare(secret, algorithm);
+  if (capacity == 0) {
+    return key;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = index.find(secret);
+  if (it == index.end()) {
+    if (entries.size() >= capacity) {
+      evict(std::prev(entries.end()));
+    }
+    entries.emplace_front();
+    entries.front().secret = secret;
+    it = index.emplace(entries.front().secret, entries.begin()).first;
+  } else {
+    entries.splice(entries.begin(), entries, it->second);
+  }
+  it->second->keys[slot] = key;
+  return key;
+}
+
+void KeyCache::evict(EntryList::iterator entry) {
+  index.erase(entry->secret);
+  SecureMemory::wipe(entry->secret.data(), entry->secret.size());
+  entries.erase(entry);
+  ++stats.evictions;
+}
+
+KeyCache::Stats KeyCache::getStats() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  Stats result = stats;
+  result.size = entries.size();
+  return result;
+}
+
+void KeyCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex);
+  for (Entry &entry : entries) {
+    SecureMemory::wipe(entry.secret.data(), entry.secret.size());
+  }
+  index.clear();
+  entries.clear();
+}
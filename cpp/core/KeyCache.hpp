@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Hmac.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Bounded, thread-safe LRU cache from Base32 secrets to prepared HMAC keys,
+// so secrets used on every render tick are decoded and keyed only once.
+// Evicted entries have their secret string wiped; the prepared key wipes its
+// own state once the last user releases it.
+class KeyCache {
+public:
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    size_t size = 0;
+    size_t capacity = 0;
+  };
+
+  explicit KeyCache(size_t capacity);
+  ~KeyCache();
+
+  KeyCache(const KeyCache &) = delete;
+  KeyCache &operator=(const KeyCache &) = delete;
+
+  // Process-wide cache shared by the TOTP and HOTP hybrid objects.
+  static KeyCache &shared();
+
+  // Returns the prepared key for `secret`, decoding it on a miss.
+  std::shared_ptr<const HMAC::Key> get(const std::string &secret,
+                                       HMAC::Algorithm algorithm);
+
+  // Decodes and keys `secret` without caching it.
+  static std::shared_ptr<const HMAC::Key> prepare(const std::string &secret,
+                                                  HMAC::Algorithm algorithm);
+
+  Stats getStats() const;
+  void clear();
+
+private:
+  struct Entry {
+    std::string secret;
+    // One prepared key per algorithm, created on demand.
+    std::array<std::shared_ptr<const HMAC::Key>, 3> keys;
+  };
+  using EntryList = std::list<Entry>;
+
+  void evict(EntryList::iterator entry);
+
+  const size_t capacity;
+  mutable std::mutex mutex;
+  // Most recently used first. Map keys view the secret stored in the entry.
+  EntryList entries;
+  std::unordered_map<std::string_view, EntryList::iterator> index;
+  Stats stats;
+};
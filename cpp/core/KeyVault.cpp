@@ -0,0 +1,184 @@
+#include "KeyVault.hpp"
+#include "Hex.hpp"
+#include "Hotp.hpp"
+#include "Random.hpp"
+#include "SecureMemory.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define NITRO_TOTP_KEY_VAULT_MMAP 1
+#endif
+
+static_assert(std::endian::native == std::endian::little,
+              "Key vault records are stored little-endian");
+
+static void checkRecord(const KeyVault::Record &record) {
+  if (record.algorithm > static_cast<uint8_t>(HMAC::Algorithm::SHA512) ||
+      record.digits < HOTP::MIN_DIGITS || record.digits > HOTP::MAX_DIGITS ||
+      record.keySize == 0 || record.keySize > KeyVault::MAX_KEY_SIZE) {
+    throw std::runtime_error("Invalid key vault record");
+  }
+}
+
+#if NITRO_TOTP_KEY_VAULT_MMAP
+
+KeyVault::KeyVault(const std::string &path) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open key vault");
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 ||
+      static_cast<size_t>(info.st_size) < sizeof(Header)) {
+    ::close(fd);
+    throw std::runtime_error("Invalid key vault");
+  }
+  size_t size = static_cast<size_t>(info.st_size);
+  void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps the file alive on its own.
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    throw std::runtime_error("Failed to map key vault");
+  }
+  data = static_cast<const uint8_t *>(mapping);
+  mappedSize = size;
+
+  const Header *header = reinterpret_cast<const Header *>(data);
+  if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      header->version != VERSION || header->recordSize != sizeof(Record) ||
+      header->count > (size - sizeof(Header)) / sizeof(Record) ||
+      size != sizeof(Header) + header->count * sizeof(Record)) {
+    munmap(mapping, mappedSize);
+    throw std::runtime_error("Invalid key vault");
+  }
+  count = static_cast<size_t>(header->count);
+
+  // Lookups jump around; read-ahead would only make untouched records
+  // resident.
+  madvise(mapping, mappedSize, MADV_RANDOM);
+}
+
+KeyVault::~KeyVault() {
+  munmap(const_cast<uint8_t *>(data), mappedSize);
+}
+
+#else
+
+KeyVault::KeyVault(const std::string &) {
+  throw std::runtime_error("Key vaults are not supported on this platform");
+}
+
+KeyVault::~KeyVault() {}
+
+#endif
+
+const KeyVault::Record *KeyVault::records() const {
+  return reinterpret_cast<const Record *>(data + sizeof(Header));
+}
+
+const KeyVault::Record &KeyVault::at(size_t index) const {
+  if (index >= count) {
+    throw std::runtime_error("Key vault index out of range");
+  }
+  const Record &record = records()[index];
+  checkRecord(record);
+  return record;
+}
+
+std::optional<size_t> KeyVault::indexOf(uint64_t id) const {
+  const Record *first = records();
+  const Record *last = first + count;
+  const Record *it = std::lower_bound(
+      first, last, id,
+      [](const Record &record, uint64_t value) { return record.id < value; });
+  if (it == last || it->id != id) {
+    return std::nullopt;
+  }
+  return static_cast<size_t>(it - first);
+}
+
+std::shared_ptr<const HMAC::Key> KeyVault::prepareKey(size_t index) const {
+  const Record &record = at(index);
+  return std::make_shared<const HMAC::Key>(
+      static_cast<HMAC::Algorithm>(record.algorithm), record.key,
+      record.keySize);
+}
+
+void KeyVault::write(const std::string &path, std::vector<Record> records) {
+  auto wipe = [&records]() {
+    SecureMemory::wipe(records.data(), records.size() * sizeof(Record));
+  };
+
+  try {
+    std::sort(records.begin(), records.end(),
+              [](const Record &a, const Record &b) { return a.id < b.id; });
+    for (size_t i = 0; i < records.size(); ++i) {
+      Record &record = records[i];
+      checkRecord(record);
+      if (i > 0 && records[i - 1].id == record.id) {
+        throw std::runtime_error("Duplicate key vault id");
+      }
+      // Unused bytes are zero, so files are byte-for-byte reproducible.
+      std::memset(record.reserved, 0, sizeof(record.reserved));
+      std::memset(record.key + record.keySize, 0,
+                  MAX_KEY_SIZE - record.keySize);
+    }
+
+    Header header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.recordSize = sizeof(Record);
+    header.count = records.size();
+
+    // Written next to the target and renamed over it, so readers never see
+    // a partial vault. The temporary name is unique, so concurrent writers
+    // of the same path each rename a complete file of their own.
+#if NITRO_TOTP_KEY_VAULT_MMAP
+    std::string temporary = path + ".XXXXXX";
+    // Owner-only, since records hold key bytes in the clear.
+    int fd = mkostemp(temporary.data(), O_CLOEXEC);
+    std::FILE *file = fd >= 0 ? fdopen(fd, "wb") : nullptr;
+    if (fd >= 0 && !file) {
+      ::close(fd);
+      std::remove(temporary.c_str());
+    }
+#else
+    uint8_t suffix[8];
+    Random::fill(suffix, sizeof(suffix));
+    std::string temporary(Hex::encodedSize(sizeof(suffix)), '\0');
+    Hex::encode(suffix, sizeof(suffix), temporary.data());
+    temporary = path + "." + temporary;
+    // "x" fails instead of reusing a file that already has this name.
+    std::FILE *file = std::fopen(temporary.c_str(), "wbx");
+#endif
+    if (!file) {
+      throw std::runtime_error("Failed to create key vault");
+    }
+    bool written =
+        std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+        (records.empty() ||
+         std::fwrite(records.data(), sizeof(Record), records.size(), file) ==
+             records.size()) &&
+        std::fflush(file) == 0;
+#if NITRO_TOTP_KEY_VAULT_MMAP
+    written = written && fsync(fileno(file)) == 0;
+#endif
+    written = std::fclose(file) == 0 && written;
+    if (!written || std::rename(temporary.c_str(), path.c_str()) != 0) {
+      std::remove(temporary.c_str());
+      throw std::runtime_error("Failed to write key vault");
+    }
+  } catch (...) {
+    wipe();
+    throw;
+  }
+  wipe();
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Hmac.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Versioned binary store of fixed-size account records, read through a
+// read-only memory mapping. Opening checks only the header, so it costs the
+// same for any number of records, and only the pages of records that are
+// actually read become resident. Records are sorted by id; multi-byte fields
+// are little-endian.
+class KeyVault {
+public:
+  static constexpr char MAGIC[8] = {'N', 'T', 'O', 'T', 'P', 'V', 'L', 'T'};
+  static constexpr uint32_t VERSION = 1;
+  static constexpr size_t MAX_KEY_SIZE = 64;
+
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t count;
+    uint8_t reserved[40];
+  };
+
+  // One account. The key starts on its own cache line.
+  struct alignas(64) Record {
+    uint64_t id;
+    // HOTP counter; unused when `period` is non-zero.
+    uint64_t counter;
+    // TOTP period in seconds, or 0 for HOTP accounts.
+    uint32_t period;
+    // An HMAC::Algorithm value.
+    uint8_t algorithm;
+    uint8_t digits;
+    uint8_t keySize;
+    uint8_t reserved[41];
+    uint8_t key[MAX_KEY_SIZE];
+  };
+
+  static_assert(sizeof(Header) == 64, "Header layout is part of the format");
+  static_assert(sizeof(Record) == 128, "Record layout is part of the format");
+
+  // Maps the vault at `path`. Throws if it cannot be read, or if its header
+  // or size do not match this format version.
+  explicit KeyVault(const std::string &path);
+  ~KeyVault();
+
+  KeyVault(const KeyVault &) = delete;
+  KeyVault &operator=(const KeyVault &) = delete;
+
+  size_t size() const { return count; }
+
+  // Throws for an index out of range or a corrupt record.
+  const Record &at(size_t index) const;
+
+  // Binary search over the sorted ids, touching O(log n) pages.
+  std::optional<size_t> indexOf(uint64_t id) const;
+
+  // Prepares the HMAC key of a record straight from the mapped bytes.
+  std::shared_ptr<const HMAC::Key> prepareKey(size_t index) const;
+
+  // Writes `records` sorted by id to `path`, replacing any existing file
+  // only once the new one is complete; with concurrent writers the last one
+  // to finish wins. Throws for duplicate ids or invalid records. `records`
+  // is wiped before returning.
+  static void write(const std::string &path, std::vector<Record> records);
+
+private:
+  const uint8_t *data = nullptr;
+  size_t mappedSize = 0;
+  size_t count = 0;
+
+  const Record *records() const;
+};
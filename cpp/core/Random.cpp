@@ -0,0 +1,51 @@
+#include "Random.hpp"
+#include "CryptoConfig.hpp"
+#include <stdexcept>
+
+#if NITRO_TOTP_OPENSSL
+#include <openssl/rand.h>
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__)
+#include <stdlib.h>
+#elif defined(__linux__)
+#include <cerrno>
+#include <sys/random.h>
+#else
+#include <cstdio>
+#endif
+
+namespace Random {
+
+void fill(uint8_t *out, size_t size) {
+#if NITRO_TOTP_OPENSSL
+  if (RAND_bytes(out, static_cast<int>(size)) != 1) {
+    throw std::runtime_error("Failed to generate secure random bytes");
+  }
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__)
+  arc4random_buf(out, size);
+#elif defined(__linux__)
+  // getrandom returns at most 32 MiB per call and may be interrupted.
+  while (size > 0) {
+    ssize_t read = getrandom(out, size, 0);
+    if (read < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error("Failed to generate secure random bytes");
+    }
+    out += read;
+    size -= static_cast<size_t>(read);
+  }
+#else
+  FILE *device = std::fopen("/dev/urandom", "rb");
+  if (!device) {
+    throw std::runtime_error("Failed to generate secure random bytes");
+  }
+  size_t read = std::fread(out, 1, size, device);
+  std::fclose(device);
+  if (read != size) {
+    throw std::runtime_error("Failed to generate secure random bytes");
+  }
+#endif
+}
+
+} // namespace Random
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Random {
+
+// Fills `size` bytes at `out` from a cryptographically secure generator:
+// OpenSSL's RAND_bytes, or the operating system's CSPRNG when built without
+// OpenSSL. Throws if the generator fails.
+void fill(uint8_t *out, size_t size);
+
+} // namespace Random
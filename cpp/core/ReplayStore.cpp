@@ -0,0 +1,94 @@
+#include "ReplayStore.hpp"
+#include <stdexcept>
+
+static size_t roundUpToPowerOfTwo(size_t value) {
+  size_t result = 8;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+// Key ids are sequential, so mix them before masking to spread the probes.
+static size_t hashId(uint64_t id) {
+  id ^= id >> 33;
+  id *= 0xff51afd7ed558ccdULL;
+  id ^= id >> 33;
+  return static_cast<size_t>(id);
+}
+
+ReplayStore::ReplayStore(size_t capacity)
+    : slots(roundUpToPowerOfTwo(capacity)) {}
+
+ReplayStore &ReplayStore::shared() {
+  static ReplayStore store;
+  return store;
+}
+
+// Index of the slot holding `id`, or of the empty slot that ends its probe
+// sequence. The load factor stays below 3/4, so an empty slot always exists.
+size_t ReplayStore::probe(uint64_t id) const {
+  size_t mask = slots.size() - 1;
+  size_t index = hashId(id) & mask;
+  while (slots[index].id != 0 && slots[index].id != id) {
+    index = (index + 1) & mask;
+  }
+  return index;
+}
+
+bool ReplayStore::accept(uint64_t id, uint64_t step, uint64_t now,
+                         uint64_t expiresAt) {
+  if (id == 0) {
+    throw std::runtime_error("Invalid replay store id");
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  size_t index = probe(id);
+  Slot &slot = slots[index];
+  if (slot.id == id) {
+    if (now < slot.expiresAt && step <= slot.step) {
+      return false;
+    }
+    slot.step = step;
+    slot.expiresAt = expiresAt;
+    return true;
+  }
+
+  if ((count + 1) * 4 > slots.size() * 3) {
+    // Drop expired records first; only grow if live ones fill half the table.
+    size_t live = 0;
+    for (const Slot &existing : slots) {
+      live += existing.id != 0 && now < existing.expiresAt;
+    }
+    rehash(live * 2 + 2 > slots.size() ? slots.size() * 2 : slots.size(),
+           now);
+    index = probe(id);
+  }
+
+  slots[index] = Slot{id, step, expiresAt};
+  ++count;
+  return true;
+}
+
+void ReplayStore::rehash(size_t capacity, uint64_t now) {
+  std::vector<Slot> previous(capacity);
+  previous.swap(slots);
+  count = 0;
+  for (const Slot &slot : previous) {
+    if (slot.id != 0 && now < slot.expiresAt) {
+      slots[probe(slot.id)] = slot;
+      ++count;
+    }
+  }
+}
+
+size_t ReplayStore::size() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return count;
+}
+
+void ReplayStore::clear() {
+  std::lock_guard<std::mutex> lock(mutex);
+  slots.assign(slots.size(), Slot());
+  count = 0;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Remembers the last accepted time step per key id so a TOTP code cannot be
+// used twice. A thread-safe open-addressing table (linear probing,
+// power-of-two capacity) of 24-byte slots. A record expires once its step
+// can no longer fall inside a validation window; expired records are swept
+// out whenever the table fills up, before it is allowed to grow.
+class ReplayStore {
+public:
+  explicit ReplayStore(size_t capacity = 64);
+
+  ReplayStore(const ReplayStore &) = delete;
+  ReplayStore &operator=(const ReplayStore &) = delete;
+
+  // Process-wide store used by the TOTP hybrid object.
+  static ReplayStore &shared();
+
+  // Records `step` for `id` and returns true if it is newer than the last
+  // step accepted for `id`; returns false for a replayed or older step.
+  // `now` and `expiresAt` share a unit (seconds); the record may be dropped
+  // once `now` reaches `expiresAt`. `id` must not be 0.
+  bool accept(uint64_t id, uint64_t step, uint64_t now, uint64_t expiresAt);
+
+  size_t size() const;
+  void clear();
+
+private:
+  struct Slot {
+    uint64_t id = 0; // 0 marks an empty slot
+    uint64_t step = 0;
+    uint64_t expiresAt = 0;
+  };
+
+  size_t probe(uint64_t id) const;
+  void rehash(size_t capacity, uint64_t now);
+
+  mutable std::mutex mutex;
+  std::vector<Slot> slots;
+  size_t count = 0;
+};
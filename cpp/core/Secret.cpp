@@ -1,27 +1,57 @@
 #include "Secret.hpp"
 #include "Base32.hpp"
+#include "Hex.hpp"
+#include "Random.hpp"
+#include "SecureMemory.hpp"
 #include <algorithm>
 #include <random>
 #include <stdexcept>
-#include <openssl/rand.h>
 
 std::vector<uint8_t> Secret::generateRandomBytes(size_t size) {
   std::vector<uint8_t> randomBytes(size);
-  if (RAND_bytes(randomBytes.data(), static_cast<int>(size)) != 1) {
-    throw std::runtime_error("Failed to generate secure random bytes");
-  }
+  Random::fill(randomBytes.data(), randomBytes.size());
 
   return randomBytes;
 }
 
+std::vector<std::string> Secret::generateBase32(size_t count, size_t size) {
+  size_t encodedSize = Base32::encodedSize(size, false);
+  std::vector<uint8_t> bytes(count * size);
+  std::string encoded(count * encodedSize, '\0');
+
+  std::vector<std::string> result;
+  try {
+    Random::fill(bytes.data(), bytes.size());
+    for (size_t i = 0; i < count; ++i) {
+      Base32::encode(bytes.data() + i * size, size,
+                     encoded.data() + i * encodedSize, false);
+    }
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      result.emplace_back(encoded.data() + i * encodedSize, encodedSize);
+    }
+  } catch (...) {
+    SecureMemory::wipe(bytes.data(), bytes.size());
+    SecureMemory::wipe(encoded.data(), encoded.size());
+    throw;
+  }
+
+  SecureMemory::wipe(bytes.data(), bytes.size());
+  SecureMemory::wipe(encoded.data(), encoded.size());
+  return result;
+}
+
 Secret::Secret(const std::vector<uint8_t> &buffer, size_t size) {
   if (buffer.empty()) {
-    bytes = generateRandomBytes(size);
+    bytes = SecureKey(size);
+    Random::fill(bytes.data(), bytes.size());
   } else {
-    bytes = buffer;
+    bytes = SecureKey(buffer.data(), buffer.size());
   }
 }
 
+Secret::Secret(SecureKey bytes) : bytes(std::move(bytes)) {}
+
 Secret Secret::fromLatin1(const std::string &str) {
   return Secret(latin1Decode(str));
 }
@@ -30,11 +60,11 @@ Secret Secret::fromUTF8(const std::string &str) {
   return Secret(utf8Decode(str));
 }
 
-Secret Secret::fromBase32(const std::string &str) {
+Secret Secret::fromBase32(std::string_view str) {
   return Secret(base32Decode(str));
 }
 
-Secret Secret::fromHex(const std::string &str) {
+Secret Secret::fromHex(std::string_view str) {
   return Secret(hexDecode(str));
 }
 
@@ -46,50 +76,52 @@ std::string Secret::getBase32() const { return base32Encode(bytes); }
 
 std::string Secret::getHex() const { return hexEncode(bytes); }
 
-const std::vector<uint8_t> &Secret::getBytes() const { return bytes; }
+const SecureKey &Secret::getBytes() const { return bytes; }
 
-std::vector<uint8_t> Secret::latin1Decode(const std::string &str) {
-  return std::vector<uint8_t>(str.begin(), str.end());
+SecureKey Secret::latin1Decode(const std::string &str) {
+  return SecureKey(reinterpret_cast<const uint8_t *>(str.data()), str.size());
 }
 
-std::vector<uint8_t> Secret::utf8Decode(const std::string &str) {
-  return std::vector<uint8_t>(str.begin(), str.end());
+SecureKey Secret::utf8Decode(const std::string &str) {
+  return SecureKey(reinterpret_cast<const uint8_t *>(str.data()), str.size());
 }
 
-std::vector<uint8_t> Secret::base32Decode(const std::string &str) {
-  return Base32::decode(str);
+SecureKey Secret::base32Decode(std::string_view str) {
+  SecureKey bytes(Base32::maxDecodedSize(str.size()));
+  bytes.resize(Base32::decode(str, bytes.data()));
+  return bytes;
 }
 
-std::vector<uint8_t> Secret::hexDecode(const std::string &str) {
-  std::vector<uint8_t> result;
-  for (size_t i = 0; i < str.size(); i += 2) {
-    std::string byte = str.substr(i, 2);
-    result.push_back(static_cast<uint8_t>(std::stoi(byte, nullptr, 16)));
+SecureKey Secret::hexDecode(std::string_view str) {
+  SecureKey result(Hex::decodedSize(str.size()));
+  switch (Hex::decode(str, result.data())) {
+  case Hex::Status::OK:
+    return result;
+  case Hex::Status::ODD_LENGTH:
+    throw std::runtime_error("Hex string has an odd number of characters");
+  case Hex::Status::INVALID_CHARACTER:
+    throw std::runtime_error("Hex string contains a non-hex character");
   }
-  return result;
+  throw std::runtime_error("Invalid hex string");
 }
 
-std::string Secret::latin1Encode(const std::vector<uint8_t> &bytes) {
-  return std::string(bytes.begin(), bytes.end());
+std::string Secret::latin1Encode(const SecureKey &bytes) {
+  return std::string(bytes.data(), bytes.data() + bytes.size());
 }
 
-std::string Secret::utf8Encode(const std::vector<uint8_t> &bytes) {
-  return std::string(bytes.begin(), bytes.end());
+std::string Secret::utf8Encode(const SecureKey &bytes) {
+  return std::string(bytes.data(), bytes.data() + bytes.size());
 }
 
-std::string Secret::base32Encode(const std::vector<uint8_t> &bytes) {
-  return Base32::encode(bytes);
+std::string Secret::base32Encode(const SecureKey &bytes) {
+  std::string result(Base32::encodedSize(bytes.size(), true), '\0');
+  result.resize(
+      Base32::encode(bytes.data(), bytes.size(), result.data(), true));
+  return result;
 }
 
-std::string Secret::hexEncode(const std::vector<uint8_t> &bytes) {
-  static const char *const lut = "0123456789ABCDEF";
-  size_t len = bytes.size();
-  std::string result;
-  result.reserve(2 * len);
-  for (size_t i = 0; i < len; ++i) {
-    const unsigned char c = bytes[i];
-    result.push_back(lut[c >> 4]);
-    result.push_back(lut[c & 15]);
-  }
+std::string Secret::hexEncode(const SecureKey &bytes) {
+  std::string result(Hex::encodedSize(bytes.size()), '\0');
+  Hex::encode(bytes.data(), bytes.size(), result.data());
   return result;
 }
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "SecureKey.hpp"
 #include <string>
+#include <string_view>
 #include <vector>
 
 class Secret {
@@ -9,32 +11,40 @@ public:
   // bytes.
   Secret(const std::vector<uint8_t> &buffer = std::vector<uint8_t>(),
          size_t size = 20);
+  explicit Secret(SecureKey bytes);
 
   static Secret fromLatin1(const std::string &str);
   static Secret fromUTF8(const std::string &str);
-  static Secret fromBase32(const std::string &str);
-  static Secret fromHex(const std::string &str);
+  static Secret fromBase32(std::string_view str);
+  // Throws for odd lengths and non-hex characters.
+  static Secret fromHex(std::string_view str);
 
   std::string getLatin1() const;
   std::string getUTF8() const;
   std::string getBase32() const;
   std::string getHex() const;
 
-  const std::vector<uint8_t> &getBytes() const;
+  // Secrets are move-only; callers borrow the bytes instead of copying them.
+  const SecureKey &getBytes() const;
 
   // Static method to generate random bytes.
   static std::vector<uint8_t> generateRandomBytes(size_t size);
 
+  // `count` random secrets of `size` bytes as unpadded Base32. The bytes come
+  // from a single CSPRNG draw and are encoded into one buffer, which is wiped
+  // along with the bytes before returning.
+  static std::vector<std::string> generateBase32(size_t count, size_t size);
+
 private:
   // Secret key bytes.
-  std::vector<uint8_t> bytes;
-  static std::vector<uint8_t> latin1Decode(const std::string &str);
-  static std::vector<uint8_t> utf8Decode(const std::string &str);
-  static std::vector<uint8_t> base32Decode(const std::string &str);
-  static std::vector<uint8_t> hexDecode(const std::string &str);
-
-  static std::string latin1Encode(const std::vector<uint8_t> &bytes);
-  static std::string utf8Encode(const std::vector<uint8_t> &bytes);
-  static std::string base32Encode(const std::vector<uint8_t> &bytes);
-  static std::string hexEncode(const std::vector<uint8_t> &bytes);
+  SecureKey bytes;
+  static SecureKey latin1Decode(const std::string &str);
+  static SecureKey utf8Decode(const std::string &str);
+  static SecureKey base32Decode(std::string_view str);
+  static SecureKey hexDecode(std::string_view str);
+
+  static std::string latin1Encode(const SecureKey &bytes);
+  static std::string utf8Encode(const SecureKey &bytes);
+  static std::string base32Encode(const SecureKey &bytes);
+  static std::string hexEncode(const SecureKey &bytes);
 };
@@ -0,0 +1,185 @@
+#include "SecureKey.hpp"
+#include "SecureMemory.hpp"
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#define NITRO_TOTP_KEY_SLAB_MMAP 1
+#endif
+
+namespace {
+
+// Hands out zeroed CAPACITY-byte slots carved from locked pages. Free slots
+// form an intrusive list through their first bytes, so acquiring and
+// releasing never allocate once a page exists. Pages are kept for the
+// lifetime of the process.
+class KeySlab {
+public:
+  // Never destroyed, so keys in static storage can still release their
+  // slots during shutdown.
+  static KeySlab &shared() {
+    static KeySlab *slab = new KeySlab();
+    return *slab;
+  }
+
+  uint8_t *acquire() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (freeList == nullptr) {
+      addPage();
+    }
+    FreeSlot *slot = freeList;
+    freeList = slot->next;
+    slot->next = nullptr;
+    return reinterpret_cast<uint8_t *>(slot);
+  }
+
+  void release(uint8_t *slot) noexcept {
+    SecureMemory::wipe(slot, SecureKey::CAPACITY);
+    std::lock_guard<std::mutex> lock(mutex);
+    FreeSlot *node = reinterpret_cast<FreeSlot *>(slot);
+    node->next = freeList;
+    freeList = node;
+  }
+
+private:
+  struct FreeSlot {
+    FreeSlot *next;
+  };
+
+  static constexpr size_t SLAB_BYTES = 4096;
+
+  void addPage() {
+#if NITRO_TOTP_KEY_SLAB_MMAP
+    void *page = mmap(nullptr, SLAB_BYTES, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANON, -1, 0);
+    if (page == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+    // Best effort: RLIMIT_MEMLOCK may be tiny, and the keys still work
+    // unlocked.
+    mlock(page, SLAB_BYTES);
+#if defined(MADV_DONTDUMP)
+    madvise(page, SLAB_BYTES, MADV_DONTDUMP);
+#endif
+#else
+    void *page = ::operator new(SLAB_BYTES,
+                                std::align_val_t(SecureKey::CAPACITY));
+    std::memset(page, 0, SLAB_BYTES);
+#endif
+    uint8_t *bytes = static_cast<uint8_t *>(page);
+    for (size_t offset = 0; offset < SLAB_BYTES;
+         offset += SecureKey::CAPACITY) {
+      FreeSlot *slot = reinterpret_cast<FreeSlot *>(bytes + offset);
+      slot->next = freeList;
+      freeList = slot;
+    }
+  }
+
+  std::mutex mutex;
+  FreeSlot *freeList = nullptr;
+};
+
+// Keys longer than a slot get their own pages, locked and kept out of core
+// dumps like the slab, and wiped before they are unmapped.
+uint8_t *acquireLarge(size_t size) {
+#if NITRO_TOTP_KEY_SLAB_MMAP
+  void *pages = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANON, -1, 0);
+  if (pages == MAP_FAILED) {
+    throw std::bad_alloc();
+  }
+  mlock(pages, size);
+#if defined(MADV_DONTDUMP)
+  madvise(pages, size, MADV_DONTDUMP);
+#endif
+  return static_cast<uint8_t *>(pages);
+#else
+  uint8_t *bytes = static_cast<uint8_t *>(::operator new(size));
+  std::memset(bytes, 0, size);
+  return bytes;
+#endif
+}
+
+void releaseLarge(uint8_t *bytes, size_t size) noexcept {
+  SecureMemory::wipe(bytes, size);
+#if NITRO_TOTP_KEY_SLAB_MMAP
+  munlock(bytes, size);
+  munmap(bytes, size);
+#else
+  ::operator delete(bytes);
+#endif
+}
+
+} // namespace
+
+SecureKey::SecureKey(size_t size) {
+  allocate(size);
+  length = size;
+}
+
+SecureKey::SecureKey(const uint8_t *data, size_t size) : SecureKey(size) {
+  if (size > 0) {
+    std::memcpy(slot, data, size);
+  }
+}
+
+SecureKey::~SecureKey() { release(); }
+
+SecureKey::SecureKey(SecureKey &&other) noexcept
+    : slot(other.slot), length(other.length), capacity(other.capacity) {
+  other.slot = nullptr;
+  other.length = 0;
+  other.capacity = 0;
+}
+
+SecureKey &SecureKey::operator=(SecureKey &&other) noexcept {
+  if (this != &other) {
+    release();
+    slot = other.slot;
+    length = other.length;
+    capacity = other.capacity;
+    other.slot = nullptr;
+    other.length = 0;
+    other.capacity = 0;
+  }
+  return *this;
+}
+
+void SecureKey::resize(size_t size) {
+  if (slot == nullptr || size > capacity) {
+    SecureKey grown(size);
+    if (length > 0) {
+      std::memcpy(grown.slot, slot, length);
+    }
+    *this = std::move(grown);
+  } else if (size < length) {
+    SecureMemory::wipe(slot + size, length - size);
+  }
+  length = size;
+}
+
+void SecureKey::allocate(size_t size) {
+  if (size <= CAPACITY) {
+    slot = KeySlab::shared().acquire();
+    capacity = CAPACITY;
+  } else {
+    slot = acquireLarge(size);
+    capacity = size;
+  }
+}
+
+void SecureKey::release() noexcept {
+  if (slot != nullptr) {
+    if (capacity == CAPACITY) {
+      KeySlab::shared().release(slot);
+    } else {
+      releaseLarge(slot, capacity);
+    }
+    slot = nullptr;
+    length = 0;
+    capacity = 0;
+  }
+}
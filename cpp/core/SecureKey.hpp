@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Move-only buffer for key material. Keys of up to CAPACITY bytes live in a
+// slot of a process-wide slab that is locked into RAM where the platform
+// allows it, so they stay out of swap and core dumps; slots are wiped when
+// released and reused without touching the heap. Longer keys get their own
+// locked pages, wiped before they are returned.
+class SecureKey {
+public:
+  // One slot, and one cache line: the largest SHA-512-sized secret.
+  // Longer keys work too, but each one costs its own allocation.
+  static constexpr size_t CAPACITY = 64;
+
+  SecureKey() noexcept = default;
+  // `size` zero bytes.
+  explicit SecureKey(size_t size);
+  // A copy of `size` bytes at `data`.
+  SecureKey(const uint8_t *data, size_t size);
+  ~SecureKey();
+
+  SecureKey(SecureKey &&other) noexcept;
+  SecureKey &operator=(SecureKey &&other) noexcept;
+  SecureKey(const SecureKey &) = delete;
+  SecureKey &operator=(const SecureKey &) = delete;
+
+  uint8_t *data() noexcept { return slot; }
+  const uint8_t *data() const noexcept { return slot; }
+  size_t size() const noexcept { return length; }
+  bool empty() const noexcept { return length == 0; }
+
+  // Shrinking wipes the dropped bytes; growing exposes zeros and may move
+  // the bytes to a larger buffer.
+  void resize(size_t size);
+
+private:
+  void allocate(size_t size);
+  void release() noexcept;
+
+  uint8_t *slot = nullptr;
+  size_t length = 0;
+  // CAPACITY for slab slots, otherwise the size of the large allocation.
+  size_t capacity = 0;
+};
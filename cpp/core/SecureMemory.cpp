@@ -0,0 +1,12 @@
+#include "SecureMemory.hpp"
+
+namespace SecureMemory {
+
+void wipe(void *data, size_t size) {
+  volatile unsigned char *p = static_cast<volatile unsigned char *>(data);
+  while (size--) {
+    *p++ = 0;
+  }
+}
+
+} // namespace SecureMemory
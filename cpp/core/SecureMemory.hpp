@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstddef>
+
+namespace SecureMemory {
+
+// Zeroes `size` bytes at `data` in a way the compiler cannot elide, for
+// wiping key material before memory is released.
+void wipe(void *data, size_t size);
+
+} // namespace SecureMemory
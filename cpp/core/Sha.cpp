@@ -0,0 +1,279 @@
+#include "Sha.hpp"
+#include <cstring>
+
+namespace SHA {
+
+static inline uint32_t rotl32(uint32_t x, int n) {
+  return (x << n) | (x >> (32 - n));
+}
+
+static inline uint32_t rotr32(uint32_t x, int n) {
+  return (x >> n) | (x << (32 - n));
+}
+
+static inline uint64_t rotr64(uint64_t x, int n) {
+  return (x >> n) | (x << (64 - n));
+}
+
+static inline uint32_t load32(const uint8_t *p) {
+  return (static_cast<uint32_t>(p[0]) << 24) |
+         (static_cast<uint32_t>(p[1]) << 16) |
+         (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+static inline uint64_t load64(const uint8_t *p) {
+  return (static_cast<uint64_t>(load32(p)) << 32) | load32(p + 4);
+}
+
+// SHA-1
+
+void Sha1::init(Word *state) {
+  state[0] = 0x67452301;
+  state[1] = 0xEFCDAB89;
+  state[2] = 0x98BADCFE;
+  state[3] = 0x10325476;
+  state[4] = 0xC3D2E1F0;
+}
+
+void Sha1::compress(Word *state, const uint8_t *block) {
+  uint32_t w[80];
+  for (int i = 0; i < 16; ++i) {
+    w[i] = load32(block + 4 * i);
+  }
+  for (int i = 16; i < 80; ++i) {
+    w[i] = rotl32(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+  }
+
+  uint32_t a = state[0], b = state[1], c = state[2], d = state[3],
+           e = state[4];
+
+  // One loop per round group keeps the boolean function branch-free.
+#define SHA1_ROUND(F, K)                                                       \
+  {                                                                            \
+    uint32_t t = rotl32(a, 5) + (F) + e + (K) + w[i];                          \
+    e = d;                                                                     \
+    d = c;                                                                     \
+    c = rotl32(b, 30);                                                         \
+    b = a;                                                                     \
+    a = t;                                                                     \
+  }
+
+  int i = 0;
+  for (; i < 20; ++i)
+    SHA1_ROUND((b & c) | (~b & d), 0x5A827999)
+  for (; i < 40; ++i)
+    SHA1_ROUND(b ^ c ^ d, 0x6ED9EBA1)
+  for (; i < 60; ++i)
+    SHA1_ROUND((b & c) | (b & d) | (c & d), 0x8F1BBCDC)
+  for (; i < 80; ++i)
+    SHA1_ROUND(b ^ c ^ d, 0xCA62C1D6)
+
+#undef SHA1_ROUND
+
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+}
+
+// SHA-256
+
+const uint32_t Sha256::ROUND_CONSTANTS[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+void Sha256::init(Word *state) {
+  state[0] = 0x6a09e667;
+  state[1] = 0xbb67ae85;
+  state[2] = 0x3c6ef372;
+  state[3] = 0xa54ff53a;
+  state[4] = 0x510e527f;
+  state[5] = 0x9b05688c;
+  state[6] = 0x1f83d9ab;
+  state[7] = 0x5be0cd19;
+}
+
+void Sha256::compress(Word *state, const uint8_t *block) {
+  uint32_t w[64];
+  for (int i = 0; i < 16; ++i) {
+    w[i] = load32(block + 4 * i);
+  }
+  for (int i = 16; i < 64; ++i) {
+    uint32_t s0 = rotr32(w[i - 15], 7) ^ rotr32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+    uint32_t s1 = rotr32(w[i - 2], 17) ^ rotr32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+
+  uint32_t a = state[0], b = state[1], c = state[2], d = state[3],
+           e = state[4], f = state[5], g = state[6], h = state[7];
+
+  for (int i = 0; i < 64; ++i) {
+    uint32_t S1 = rotr32(e, 6) ^ rotr32(e, 11) ^ rotr32(e, 25);
+    uint32_t ch = (e & f) ^ (~e & g);
+    uint32_t t1 = h + S1 + ch + ROUND_CONSTANTS[i] + w[i];
+    uint32_t S0 = rotr32(a, 2) ^ rotr32(a, 13) ^ rotr32(a, 22);
+    uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+    uint32_t t2 = S0 + maj;
+    h = g;
+    g = f;
+    f = e;
+    e = d + t1;
+    d = c;
+    c = b;
+    b = a;
+    a = t1 + t2;
+  }
+
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+  state[5] += f;
+  state[6] += g;
+  state[7] += h;
+}
+
+// SHA-512
+
+static const uint64_t K512[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL,
+    0xe9b5dba58189dbbcULL, 0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL,
+    0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL, 0xd807aa98a3030242ULL,
+    0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL,
+    0xc19bf174cf692694ULL, 0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL,
+    0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL, 0x2de92c6f592b0275ULL,
+    0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL,
+    0xbf597fc7beef0ee4ULL, 0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL,
+    0x06ca6351e003826fULL, 0x142929670a0e6e70ULL, 0x27b70a8546d22ffcULL,
+    0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL,
+    0x92722c851482353bULL, 0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL,
+    0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL, 0xd192e819d6ef5218ULL,
+    0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL,
+    0x34b0bcb5e19b48a8ULL, 0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL,
+    0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL, 0x748f82ee5defb2fcULL,
+    0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL,
+    0xc67178f2e372532bULL, 0xca273eceea26619cULL, 0xd186b8c721c0c207ULL,
+    0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL, 0x06f067aa72176fbaULL,
+    0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL,
+    0x431d67c49c100d4cULL, 0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL,
+    0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL};
+
+void Sha512::init(Word *state) {
+  state[0] = 0x6a09e667f3bcc908ULL;
+  state[1] = 0xbb67ae8584caa73bULL;
+  state[2] = 0x3c6ef372fe94f82bULL;
+  state[3] = 0xa54ff53a5f1d36f1ULL;
+  state[4] = 0x510e527fade682d1ULL;
+  state[5] = 0x9b05688c2b3e6c1fULL;
+  state[6] = 0x1f83d9abfb41bd6bULL;
+  state[7] = 0x5be0cd19137e2179ULL;
+}
+
+void Sha512::compress(Word *state, const uint8_t *block) {
+  uint64_t w[80];
+  for (int i = 0; i < 16; ++i) {
+    w[i] = load64(block + 8 * i);
+  }
+  for (int i = 16; i < 80; ++i) {
+    uint64_t s0 = rotr64(w[i - 15], 1) ^ rotr64(w[i - 15], 8) ^ (w[i - 15] >> 7);
+    uint64_t s1 = rotr64(w[i - 2], 19) ^ rotr64(w[i - 2], 61) ^ (w[i - 2] >> 6);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+
+  uint64_t a = state[0], b = state[1], c = state[2], d = state[3],
+           e = state[4], f = state[5], g = state[6], h = state[7];
+
+  for (int i = 0; i < 80; ++i) {
+    uint64_t S1 = rotr64(e, 14) ^ rotr64(e, 18) ^ rotr64(e, 41);
+    uint64_t ch = (e & f) ^ (~e & g);
+    uint64_t t1 = h + S1 + ch + K512[i] + w[i];
+    uint64_t S0 = rotr64(a, 28) ^ rotr64(a, 34) ^ rotr64(a, 39);
+    uint64_t maj = (a & b) ^ (a & c) ^ (b & c);
+    uint64_t t2 = S0 + maj;
+    h = g;
+    g = f;
+    f = e;
+    e = d + t1;
+    d = c;
+    c = b;
+    b = a;
+    a = t1 + t2;
+  }
+
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+  state[5] += f;
+  state[6] += g;
+  state[7] += h;
+}
+
+// Padding
+
+template <typename H>
+void finish(typename H::Word *state, const uint8_t *data, size_t size,
+            uint64_t processed, uint8_t *out) {
+  while (size >= H::BLOCK_SIZE) {
+    H::compress(state, data);
+    data += H::BLOCK_SIZE;
+    size -= H::BLOCK_SIZE;
+    processed += H::BLOCK_SIZE;
+  }
+
+  uint8_t block[2 * H::BLOCK_SIZE] = {};
+  if (size > 0) {
+    std::memcpy(block, data, size);
+  }
+  block[size] = 0x80;
+
+  size_t blocks = (size + 1 + H::LENGTH_SIZE <= H::BLOCK_SIZE) ? 1 : 2;
+  size_t end = blocks * H::BLOCK_SIZE;
+  uint64_t bits = (processed + size) * 8;
+  for (int i = 0; i < 8; ++i) {
+    block[end - 1 - i] = static_cast<uint8_t>(bits >> (8 * i));
+  }
+
+  for (size_t i = 0; i < blocks; ++i) {
+    H::compress(state, block + i * H::BLOCK_SIZE);
+  }
+
+  storeDigest<H>(state, out);
+}
+
+template <typename H>
+void hash(const uint8_t *data, size_t size, uint8_t *out) {
+  typename H::Word state[H::STATE_WORDS];
+  H::init(state);
+  finish<H>(state, data, size, 0, out);
+}
+
+template void finish<Sha1>(Sha1::Word *, const uint8_t *, size_t, uint64_t,
+                           uint8_t *);
+template void finish<Sha256>(Sha256::Word *, const uint8_t *, size_t,
+                             uint64_t, uint8_t *);
+template void finish<Sha512>(Sha512::Word *, const uint8_t *, size_t,
+                             uint64_t, uint8_t *);
+template void hash<Sha1>(const uint8_t *, size_t, uint8_t *);
+template void hash<Sha256>(const uint8_t *, size_t, uint8_t *);
+template void hash<Sha512>(const uint8_t *, size_t, uint8_t *);
+
+} // namespace SHA
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Portable SHA-1/SHA-256/SHA-512 compression functions. These are the
+// building blocks of the in-tree HMAC engine: callers keep intermediate
+// states around (e.g. HMAC ipad/opad) and only run the rounds they need.
+namespace SHA {
+
+struct Sha1 {
+  using Word = uint32_t;
+  static constexpr size_t BLOCK_SIZE = 64;
+  static constexpr size_t DIGEST_SIZE = 20;
+  static constexpr size_t STATE_WORDS = 5;
+  static constexpr size_t LENGTH_SIZE = 8;
+
+  static void init(Word *state);
+  static void compress(Word *state, const uint8_t *block);
+};
+
+struct Sha256 {
+  using Word = uint32_t;
+  static constexpr size_t BLOCK_SIZE = 64;
+  static constexpr size_t DIGEST_SIZE = 32;
+  static constexpr size_t STATE_WORDS = 8;
+  static constexpr size_t LENGTH_SIZE = 8;
+  static const Word ROUND_CONSTANTS[64];
+
+  static void init(Word *state);
+  static void compress(Word *state, const uint8_t *block);
+};
+
+struct Sha512 {
+  using Word = uint64_t;
+  static constexpr size_t BLOCK_SIZE = 128;
+  static constexpr size_t DIGEST_SIZE = 64;
+  static constexpr size_t STATE_WORDS = 8;
+  static constexpr size_t LENGTH_SIZE = 16;
+
+  static void init(Word *state);
+  static void compress(Word *state, const uint8_t *block);
+};
+
+// Continues hashing from `state`, which has already absorbed `processed`
+// bytes (a multiple of the block size), and writes the final digest.
+template <typename H>
+void finish(typename H::Word *state, const uint8_t *data, size_t size,
+            uint64_t processed, uint8_t *out);
+
+// One-shot hash of `data`, used to shorten HMAC keys longer than a block.
+template <typename H> void hash(const uint8_t *data, size_t size, uint8_t *out);
+
+// Big-endian state serialization shared by the HMAC engines.
+template <typename H>
+inline void storeDigest(const typename H::Word *state, uint8_t *out) {
+  constexpr size_t wordSize = sizeof(typename H::Word);
+  for (size_t i = 0; i < H::DIGEST_SIZE; ++i) {
+    out[i] = static_cast<uint8_t>(state[i / wordSize] >>
+                                  (8 * (wordSize - 1 - i % wordSize)));
+  }
+}
+
+} // namespace SHA
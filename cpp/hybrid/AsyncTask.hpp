@@ -0,0 +1,29 @@
+#pragma once
+
+#include "../utils/ThreadPool.hpp"
+#include <NitroModules/Promise.hpp>
+#include <exception>
+#include <memory>
+#include <utility>
+
+namespace margelo::nitro::totp {
+
+// Runs `task` on the shared thread pool and settles the returned promise with
+// its result, or rejects it with whatever `task` threw. Captures must own
+// everything the task touches, including the hybrid object itself, since the
+// JS side may drop its reference before the task runs.
+template <typename T, typename Task>
+std::shared_ptr<Promise<T>> runAsync(Task &&task) {
+  std::shared_ptr<Promise<T>> promise = Promise<T>::create();
+  ThreadPool::shared().submit(
+      [promise, task = std::forward<Task>(task)]() mutable {
+        try {
+          promise->resolve(task());
+        } catch (...) {
+          promise->reject(std::current_exception());
+        }
+      });
+  return promise;
+}
+
+} // namespace margelo::nitro::totp
@@ -1,65 +1,108 @@
 #include "HybridNitroHotp.hpp"
+#include "AsyncTask.hpp"
 #include "../core/Hmac.hpp"
-#include "../core/Secret.hpp"
+#include "../core/KeyCache.hpp"
 #include "../utils/BaseOptions.hpp"
 #include "../utils/Utils.hpp"
-#include <cmath>
-#include <stdexcept>
 
 namespace margelo::nitro::totp {
 
-std::string HybridNitroHotp::generate(const std::string &secret,
+std::string HybridNitroHotp::generate(const SecretOrKey &secret,
                                       const NitroHotpGenerateOptions &options) {
   int digits = options.digits.value();
-  std::string algorithm = Utils::getAlgorithmName(options.algorithm.value());
+  HMAC::Algorithm algorithm =
+      Utils::getHmacAlgorithm(options.algorithm.value());
   uint64_t counter = options.counter.value();
 
-  std::vector<uint8_t> key = Secret::fromBase32(secret).getBytes();
-
-  uint8_t data[8];
-  uint64_t counterCopy = counter;
-  for (int i = 7; i >= 0; --i) {
-    data[i] = static_cast<uint8_t>(counterCopy & 0xFF);
-    counterCopy >>= 8;
-  }
-
-  std::vector<uint8_t> hmacResult =
-      HMAC::compute(algorithm, key, std::vector<uint8_t>(data, data + 8));
+  return Utils::generateOtp(secret, algorithm, counter, digits);
+}
 
-  int offset = hmacResult[hmacResult.size() - 1] & 0x0F;
-  uint32_t binaryCode = ((hmacResult[offset] & 0x7F) << 24) |
-                        ((hmacResult[offset + 1] & 0xFF) << 16) |
-                        ((hmacResult[offset + 2] & 0xFF) << 8) |
-                        (hmacResult[offset + 3] & 0xFF);
+std::vector<std::string>
+HybridNitroHotp::generateMany(const std::vector<std::string> &secrets,
+                              const NitroHotpGenerateOptions &options) {
+  // Unpack the options once for the whole batch
+  int digits = options.digits.value();
+  HMAC::Algorithm algorithm =
+      Utils::getHmacAlgorithm(options.algorithm.value());
+  uint64_t counter = options.counter.value();
 
-  uint32_t otp = binaryCode % static_cast<uint32_t>(std::pow(10, digits));
+  return Utils::generateOtps(secrets, algorithm, counter, digits);
+}
 
-  return Utils::formatOtp(otp, digits);
+bool HybridNitroHotp::validate(const SecretOrKey &secret,
+                               const std::string &otp,
+                               const NitroHotpValidateOptions &options) {
+  return validateDelta(secret, otp, options).has_value();
 }
 
-bool HybridNitroHotp::validate(const std::string &secret,
+std::optional<double>
+HybridNitroHotp::validateDelta(const SecretOrKey &secret,
                                const std::string &otp,
                                const NitroHotpValidateOptions &options) {
 
   // Default values
   int digits = options.digits.value();
-  SupportedAlgorithm algorithm = options.algorithm.value();
+  HMAC::Algorithm algorithm =
+      Utils::getHmacAlgorithm(options.algorithm.value());
   uint64_t counter = options.counter.value();
-  int window = options.window.value();
+  int window = Utils::getWindow(options.window.value());
+  bool parallel = options.parallel.value_or(false);
+  bool constantTime = options.constantTime.value_or(false);
+
+  std::optional<int> delta = Utils::findOtp(
+      secret, otp, algorithm, counter, window, digits, parallel, constantTime);
+  if (!delta) {
+    return std::nullopt;
+  }
+  return static_cast<double>(*delta);
+}
 
-  for (int i = -window; i <= window; ++i) {
-    uint64_t testCounter = counter + i;
+NitroKeyCacheStats HybridNitroHotp::getKeyCacheStats() {
+  return Utils::toNitroKeyCacheStats(KeyCache::shared().getStats());
+}
 
-    NitroHotpGenerateOptions generationOptions(testCounter, digits, algorithm);
+void HybridNitroHotp::clearKeyCache() { KeyCache::shared().clear(); }
 
-    std::string generatedOtp = generate(secret, generationOptions);
+std::shared_ptr<Promise<std::string>>
+HybridNitroHotp::generateAsync(const SecretOrKey &secret,
+                               const NitroHotpGenerateOptions &options) {
+  return runAsync<std::string>(
+      [self = self(), secret = Utils::toOwned(secret), options]() {
+        return self->generate(secret, options);
+      });
+}
 
-    if (generatedOtp == otp) {
-      return true;
-    }
-  }
+std::shared_ptr<Promise<std::vector<std::string>>>
+HybridNitroHotp::generateManyAsync(const std::vector<std::string> &secrets,
+                                   const NitroHotpGenerateOptions &options) {
+  return runAsync<std::vector<std::string>>(
+      [self = self(), secrets, options]() {
+        return self->generateMany(secrets, options);
+      });
+}
+
+std::shared_ptr<Promise<bool>>
+HybridNitroHotp::validateAsync(const SecretOrKey &secret,
+                               const std::string &otp,
+                               const NitroHotpValidateOptions &options) {
+  return runAsync<bool>(
+      [self = self(), secret = Utils::toOwned(secret), otp, options]() {
+        return self->validate(secret, otp, options);
+      });
+}
+
+std::shared_ptr<Promise<std::optional<double>>>
+HybridNitroHotp::validateDeltaAsync(const SecretOrKey &secret,
+                                    const std::string &otp,
+                                    const NitroHotpValidateOptions &options) {
+  return runAsync<std::optional<double>>(
+      [self = self(), secret = Utils::toOwned(secret), otp, options]() {
+        return self->validateDelta(secret, otp, options);
+      });
+}
 
-  return false;
+std::shared_ptr<HybridNitroHotp> HybridNitroHotp::self() {
+  return std::dynamic_pointer_cast<HybridNitroHotp>(shared_from_this());
 }
 
 } // namespace margelo::nitro::totp
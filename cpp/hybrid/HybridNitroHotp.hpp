@@ -1,7 +1,10 @@
 #pragma once
 
 #include "HybridNitroHotpSpec.hpp"
+#include "HybridNitroTotpKey.hpp"
+#include <optional>
 #include <string>
+#include <vector>
 
 namespace margelo::nitro::totp {
 
@@ -10,15 +13,47 @@ public:
   HybridNitroHotp() : HybridObject(TAG) {}
 
 public:
-  std::string generate(const std::string &secret,
+  std::string generate(const SecretOrKey &secret,
                        const NitroHotpGenerateOptions &options) override;
 
-  bool validate(const std::string &secret, const std::string &otp,
+  std::shared_ptr<Promise<std::string>>
+  generateAsync(const SecretOrKey &secret,
+                const NitroHotpGenerateOptions &options) override;
+
+  std::vector<std::string>
+  generateMany(const std::vector<std::string> &secrets,
+               const NitroHotpGenerateOptions &options) override;
+
+  std::shared_ptr<Promise<std::vector<std::string>>>
+  generateManyAsync(const std::vector<std::string> &secrets,
+                    const NitroHotpGenerateOptions &options) override;
+
+  bool validate(const SecretOrKey &secret, const std::string &otp,
                 const NitroHotpValidateOptions &options) override;
 
+  std::shared_ptr<Promise<bool>>
+  validateAsync(const SecretOrKey &secret, const std::string &otp,
+                const NitroHotpValidateOptions &options) override;
+
+  std::optional<double>
+  validateDelta(const SecretOrKey &secret, const std::string &otp,
+                const NitroHotpValidateOptions &options) override;
+
+  std::shared_ptr<Promise<std::optional<double>>>
+  validateDeltaAsync(const SecretOrKey &secret, const std::string &otp,
+                     const NitroHotpValidateOptions &options) override;
+
+  NitroKeyCacheStats getKeyCacheStats() override;
+
+  void clearKeyCache() override;
+
   void loadHybridMethods() override {
     // call base protoype
     HybridNitroHotpSpec::loadHybridMethods();
   }
+
+private:
+  // Keeps this object alive while a task queued by an *Async method runs.
+  std::shared_ptr<HybridNitroHotp> self();
 };
 } // namespace margelo::nitro::totp
@@ -0,0 +1,88 @@
+#include "HybridNitroKeyVault.hpp"
+#include "HybridNitroTotpKey.hpp"
+#include "../core/Hotp.hpp"
+#include "../utils/Utils.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace margelo::nitro::totp {
+
+// Largest integer a JS number holds exactly.
+static constexpr double MAX_SAFE_INTEGER = 9007199254740992.0;
+
+static size_t getIndex(const KeyVault &vault, double index) {
+  if (index < 0.0 || index != std::floor(index) ||
+      index >= static_cast<double>(vault.size())) {
+    throw std::runtime_error("Key vault index out of range");
+  }
+  return static_cast<size_t>(index);
+}
+
+double HybridNitroKeyVault::getSize() {
+  return static_cast<double>(get()->size());
+}
+
+double HybridNitroKeyVault::indexOf(double id) {
+  std::shared_ptr<const KeyVault> current = get();
+  if (id < 0.0 || id > MAX_SAFE_INTEGER || id != std::floor(id)) {
+    return -1.0;
+  }
+  std::optional<size_t> index = current->indexOf(static_cast<uint64_t>(id));
+  return index ? static_cast<double>(*index) : -1.0;
+}
+
+NitroKeyVaultEntry HybridNitroKeyVault::getEntry(double index) {
+  std::shared_ptr<const KeyVault> current = get();
+  const KeyVault::Record &record = current->at(getIndex(*current, index));
+  return NitroKeyVaultEntry(
+      static_cast<double>(record.id),
+      Utils::getSupportedAlgorithm(
+          static_cast<HMAC::Algorithm>(record.algorithm)),
+      static_cast<double>(record.digits), static_cast<double>(record.period),
+      static_cast<double>(record.counter));
+}
+
+std::shared_ptr<HybridNitroTotpKeySpec>
+HybridNitroKeyVault::createKey(double index) {
+  std::shared_ptr<const KeyVault> current = get();
+  std::shared_ptr<const HMAC::Key> key =
+      current->prepareKey(getIndex(*current, index));
+  SupportedAlgorithm algorithm =
+      Utils::getSupportedAlgorithm(key->getAlgorithm());
+  return std::make_shared<HybridNitroTotpKey>(std::move(key), algorithm);
+}
+
+std::string HybridNitroKeyVault::generate(double index, double currentTime) {
+  std::shared_ptr<const KeyVault> current = get();
+  size_t position = getIndex(*current, index);
+  const KeyVault::Record &record = current->at(position);
+
+  uint64_t counter = record.counter;
+  if (record.period > 0) {
+    // Checked in double first: casting NaN, infinities or values past
+    // 2^64 to an integer is undefined.
+    if (!std::isfinite(currentTime) || currentTime < 0.0 ||
+        currentTime > MAX_SAFE_INTEGER) {
+      throw std::runtime_error("Invalid current time");
+    }
+    counter = static_cast<uint64_t>(currentTime) / record.period;
+  }
+  std::shared_ptr<const HMAC::Key> key = current->prepareKey(position);
+  return Utils::formatOtp(HOTP::compute(*key, counter, record.digits),
+                          record.digits);
+}
+
+void HybridNitroKeyVault::close() {
+  std::lock_guard<std::mutex> lock(mutex);
+  vault.reset();
+}
+
+std::shared_ptr<const KeyVault> HybridNitroKeyVault::get() {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (!vault) {
+    throw std::runtime_error("Key vault is closed");
+  }
+  return vault;
+}
+
+} // namespace margelo::nitro::totp
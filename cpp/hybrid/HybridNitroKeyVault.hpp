@@ -0,0 +1,42 @@
+#pragma once
+
+#include "../core/KeyVault.hpp"
+#include "HybridNitroKeyVaultSpec.hpp"
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace margelo::nitro::totp {
+
+// JS handle to a mapped KeyVault. close() unmaps it once no call is still
+// reading from it; any later call throws.
+class HybridNitroKeyVault : public HybridNitroKeyVaultSpec {
+public:
+  explicit HybridNitroKeyVault(std::shared_ptr<const KeyVault> vault)
+      : HybridObject(TAG), vault(std::move(vault)) {}
+
+public:
+  double getSize() override;
+
+  double indexOf(double id) override;
+
+  NitroKeyVaultEntry getEntry(double index) override;
+
+  std::shared_ptr<HybridNitroTotpKeySpec> createKey(double index) override;
+
+  std::string generate(double index, double currentTime) override;
+
+  void close() override;
+
+  void loadHybridMethods() override {
+    // call base protoype
+    HybridNitroKeyVaultSpec::loadHybridMethods();
+  }
+
+private:
+  std::mutex mutex;
+  std::shared_ptr<const KeyVault> vault;
+
+  std::shared_ptr<const KeyVault> get();
+};
+} // namespace margelo::nitro::totp
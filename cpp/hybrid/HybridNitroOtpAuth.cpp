@@ -0,0 +1,135 @@
+#include "HybridNitroOtpAuth.hpp"
+#include "HybridNitroTotpKey.hpp"
+#include "../core/Hotp.hpp"
+#include "../core/SecureMemory.hpp"
+#include "../utils/MigrationPayload.hpp"
+#include "../utils/OtpAuthUri.hpp"
+#include "../utils/Utils.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace margelo::nitro::totp {
+
+static constexpr double MAX_SAFE_INTEGER = 9007199254740992.0;
+
+static NitroOtpAuthURI toNitroOtpAuthURI(const OtpAuthUri &uri) {
+  return NitroOtpAuthURI(uri.type == OtpAuthUri::Type::HOTP ? OtpAuthType::HOTP
+                                                            : OtpAuthType::TOTP,
+                         std::string(uri.issuer), std::string(uri.account),
+                         std::string(uri.secret),
+                         Utils::getSupportedAlgorithm(uri.algorithm),
+                         static_cast<double>(uri.digits),
+                         static_cast<double>(uri.period),
+                         static_cast<double>(uri.counter));
+}
+
+NitroOtpAuthURI HybridNitroOtpAuth::parse(const std::string &uri) {
+  OtpAuthArena arena(uri.size());
+  OtpAuthUri parsed;
+  if (!OtpAuth::parse(uri, arena, parsed)) {
+    throw std::runtime_error("Invalid otpauth URI");
+  }
+  return toNitroOtpAuthURI(parsed);
+}
+
+std::vector<std::optional<NitroOtpAuthURI>>
+HybridNitroOtpAuth::parseMany(const std::vector<std::string> &uris) {
+  // One arena for the whole batch, sized so it never has to grow.
+  size_t capacity = 0;
+  for (const std::string &uri : uris) {
+    capacity += uri.size();
+  }
+  OtpAuthArena arena(capacity);
+
+  std::vector<std::optional<NitroOtpAuthURI>> result;
+  result.reserve(uris.size());
+  OtpAuthUri parsed;
+  for (const std::string &uri : uris) {
+    if (OtpAuth::parse(uri, arena, parsed)) {
+      result.emplace_back(toNitroOtpAuthURI(parsed));
+    } else {
+      result.emplace_back(std::nullopt);
+    }
+  }
+  return result;
+}
+
+std::string HybridNitroOtpAuth::build(const NitroOtpAuthURI &uri,
+                                      bool issuerInLabel) {
+  if (uri.secret.empty()) {
+    throw std::runtime_error("Secret is required.");
+  }
+  if (uri.digits < HOTP::MIN_DIGITS || uri.digits > HOTP::MAX_DIGITS ||
+      uri.digits != std::floor(uri.digits)) {
+    throw std::runtime_error("Invalid digits");
+  }
+  if (!(uri.period >= 1 && uri.period <= MAX_SAFE_INTEGER) ||
+      uri.period != std::floor(uri.period)) {
+    throw std::runtime_error("Invalid period");
+  }
+  if (!(uri.counter >= 0 && uri.counter <= MAX_SAFE_INTEGER) ||
+      uri.counter != std::floor(uri.counter)) {
+    throw std::runtime_error("Invalid counter");
+  }
+
+  OtpAuthUri fields;
+  fields.type = uri.type == OtpAuthType::HOTP ? OtpAuthUri::Type::HOTP
+                                              : OtpAuthUri::Type::TOTP;
+  fields.issuer = uri.issuer;
+  fields.account = uri.label;
+  fields.secret = uri.secret;
+  fields.algorithm = Utils::getHmacAlgorithm(uri.algorithm);
+  fields.digits = static_cast<int>(uri.digits);
+  fields.period = static_cast<uint64_t>(uri.period);
+  fields.counter = static_cast<uint64_t>(uri.counter);
+
+  std::string result;
+  result.reserve(64 + 3 * (uri.issuer.size() * 2 + uri.label.size()) +
+                 uri.secret.size());
+  OtpAuth::build(fields, issuerInLabel, result);
+  return result;
+}
+
+// The export has no period field; Google Authenticator only uses 30 seconds.
+static constexpr double MIGRATION_PERIOD = 30.0;
+
+std::vector<NitroOtpAuthAccount>
+HybridNitroOtpAuth::parseMigration(const std::string &uri) {
+  std::vector<uint8_t> payload;
+  std::vector<NitroOtpAuthAccount> result;
+
+  // Secrets go straight from the payload into prepared keys, without a
+  // round trip through Base32 strings.
+  auto onAccount = [&result](const MigrationAccount &account) {
+    auto key = std::make_shared<const HMAC::Key>(
+        account.algorithm, account.secret, account.secretSize);
+    SupportedAlgorithm algorithm =
+        Utils::getSupportedAlgorithm(account.algorithm);
+    result.emplace_back(account.type == OtpAuthUri::Type::HOTP
+                            ? OtpAuthType::HOTP
+                            : OtpAuthType::TOTP,
+                        std::string(account.issuer),
+                        std::string(account.name), algorithm,
+                        static_cast<double>(account.digits), MIGRATION_PERIOD,
+                        static_cast<double>(account.counter),
+                        std::make_shared<HybridNitroTotpKey>(std::move(key),
+                                                             algorithm));
+  };
+
+  bool valid;
+  try {
+    valid = Migration::decodeUri(uri, payload) &&
+            Migration::decode(payload.data(), payload.size(), onAccount);
+  } catch (...) {
+    SecureMemory::wipe(payload.data(), payload.size());
+    throw;
+  }
+  SecureMemory::wipe(payload.data(), payload.size());
+
+  if (!valid) {
+    throw std::runtime_error("Invalid otpauth-migration URI");
+  }
+  return result;
+}
+
+} // namespace margelo::nitro::totp
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "HybridNitroOtpAuthSpec.hpp"
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::totp {
+
+class HybridNitroOtpAuth : public HybridNitroOtpAuthSpec {
+public:
+  HybridNitroOtpAuth() : HybridObject(TAG) {}
+
+public:
+  NitroOtpAuthURI parse(const std::string &uri) override;
+
+  std::vector<std::optional<NitroOtpAuthURI>>
+  parseMany(const std::vector<std::string> &uris) override;
+
+  std::string build(const NitroOtpAuthURI &uri, bool issuerInLabel) override;
+
+  std::vector<NitroOtpAuthAccount>
+  parseMigration(const std::string &uri) override;
+
+  void loadHybridMethods() override {
+    // call base protoype
+    HybridNitroOtpAuthSpec::loadHybridMethods();
+  }
+};
+} // namespace margelo::nitro::totp
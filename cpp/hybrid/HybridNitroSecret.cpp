@@ -1,15 +1,25 @@
 #include "HybridNitroSecret.hpp"
-#include "../core/Base32.hpp"
-#include "../utils/BaseOptions.hpp"
+#include "AsyncTask.hpp"
+#include "HybridNitroKeyVault.hpp"
+#include "HybridNitroTotpKey.hpp"
+#include "../core/Hotp.hpp"
+#include "../core/KeyCache.hpp"
+#include "../core/KeyVault.hpp"
+#include "../core/Random.hpp"
 #include "../core/Secret.hpp"
-#include <limits>
+#include "../core/SecureMemory.hpp"
+#include "../utils/Utils.hpp"
 #include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
 
 namespace margelo::nitro::totp {
-std::string
-HybridNitroSecret::generate(const GenerateSecretKeyOptions &options) {
-  int keySize = BaseSecretKeyOptions::size;
 
+// Secret size in bytes for `options.size`, which is either a SecretSize enum
+// value or a byte count.
+static size_t getSecretSize(const GenerateSecretKeyOptions &options) {
   double size = options.size.value();
 
   if (size < 0.0 || size != std::floor(size)) {
@@ -19,25 +29,130 @@ HybridNitroSecret::generate(const GenerateSecretKeyOptions &options) {
   // Convert enum values to actual byte sizes
   // 0 = COMPACT (16 bytes), 1 = STANDARD (20 bytes), 2 = EXTENDED (32 bytes)
   if (size == 0.0) {
-    keySize = 16; // COMPACT
+    return 16; // COMPACT
   } else if (size == 1.0) {
-    keySize = 20; // STANDARD
+    return 20; // STANDARD
   } else if (size == 2.0) {
-    keySize = 32; // EXTENDED
-  } else {
-    // Allow direct byte values for backward compatibility
-    if (size != 16.0 && size != 20.0 && size != 32.0) {
-      throw std::runtime_error("Secret size must be 16, 20, or 32 bytes (or use enum values 0, 1, 2)");
-    }
-    keySize = static_cast<int>(size);
-  }  if (size > 0.0) {
-    keySize = static_cast<int>(size);
+    return 32; // EXTENDED
   }
+  // Allow direct byte values for backward compatibility
+  if (size != 16.0 && size != 20.0 && size != 32.0) {
+    throw std::runtime_error("Secret size must be 16, 20, or 32 bytes (or use enum values 0, 1, 2)");
+  }
+  return static_cast<size_t>(size);
+}
 
-  Secret secret(std::vector<uint8_t>(), keySize);
+// `value` as an integer in [0, max], for the numeric fields of a vault record.
+static uint64_t getVaultField(double value, double max, const char *name) {
+  if (value < 0.0 || value > max || value != std::floor(value)) {
+    throw std::runtime_error(std::string("Invalid key vault ") + name);
+  }
+  return static_cast<uint64_t>(value);
+}
 
-  const std::string cleanedSecretKey = Base32::clean(secret.getBase32());
+std::string
+HybridNitroSecret::generate(const GenerateSecretKeyOptions &options) {
+  return Secret::generateBase32(1, getSecretSize(options)).front();
+}
+
+std::vector<std::string>
+HybridNitroSecret::generateMany(double count,
+                                const GenerateSecretKeyOptions &options) {
+  if (count < 0.0 || count != std::floor(count) ||
+      count > static_cast<double>(MAX_GENERATE_MANY)) {
+    throw std::runtime_error("Secret count must be an integer from 0 to " +
+                             std::to_string(MAX_GENERATE_MANY));
+  }
+  return Secret::generateBase32(static_cast<size_t>(count),
+                                getSecretSize(options));
+}
+
+std::shared_ptr<Promise<std::string>>
+HybridNitroSecret::generateAsync(const GenerateSecretKeyOptions &options) {
+  return runAsync<std::string>(
+      [self = self(), options]() { return self->generate(options); });
+}
 
-  return cleanedSecretKey;
+std::shared_ptr<Promise<std::vector<std::string>>>
+HybridNitroSecret::generateManyAsync(double count,
+                                     const GenerateSecretKeyOptions &options) {
+  return runAsync<std::vector<std::string>>(
+      [self = self(), count, options]() {
+        return self->generateMany(count, options);
+      });
 }
+
+std::shared_ptr<ArrayBuffer>
+HybridNitroSecret::generateBytes(const GenerateSecretKeyOptions &options) {
+  size_t size = getSecretSize(options);
+  std::shared_ptr<ArrayBuffer> bytes = ArrayBuffer::allocate(size);
+  Random::fill(bytes->data(), size);
+  return bytes;
+}
+
+std::shared_ptr<HybridNitroTotpKeySpec> HybridNitroSecret::createKey(
+    const std::variant<std::string, std::shared_ptr<ArrayBuffer>> &secret,
+    SupportedAlgorithm algorithm) {
+  // The handle owns its key outright, so it never competes for cache slots.
+  HMAC::Algorithm hmacAlgorithm = Utils::getHmacAlgorithm(algorithm);
+  std::shared_ptr<const HMAC::Key> key =
+      std::holds_alternative<std::string>(secret)
+          ? KeyCache::prepare(std::get<std::string>(secret), hmacAlgorithm)
+          : Utils::prepareKey(std::get<std::shared_ptr<ArrayBuffer>>(secret),
+                              hmacAlgorithm);
+
+  return std::make_shared<HybridNitroTotpKey>(std::move(key), algorithm);
+}
+
+std::shared_ptr<HybridNitroKeyVaultSpec>
+HybridNitroSecret::openVault(const std::string &path) {
+  return std::make_shared<HybridNitroKeyVault>(
+      std::make_shared<const KeyVault>(path));
+}
+
+void HybridNitroSecret::writeVault(
+    const std::string &path, const std::vector<NitroKeyVaultRecord> &records) {
+  // Ids and counters must survive the round trip through a JS number.
+  constexpr double MAX_SAFE_INTEGER = 9007199254740992.0;
+
+  std::vector<KeyVault::Record> vaultRecords(records.size());
+  try {
+    for (size_t i = 0; i < records.size(); ++i) {
+      const NitroKeyVaultRecord &source = records[i];
+      KeyVault::Record &record = vaultRecords[i];
+      record.id = getVaultField(source.id, MAX_SAFE_INTEGER, "id");
+      record.counter =
+          getVaultField(source.counter, MAX_SAFE_INTEGER, "counter");
+      record.period = static_cast<uint32_t>(getVaultField(
+          source.period, std::numeric_limits<uint32_t>::max(), "period"));
+      record.algorithm = static_cast<uint8_t>(
+          Utils::getHmacAlgorithm(source.algorithm));
+      record.digits = static_cast<uint8_t>(
+          getVaultField(source.digits, HOTP::MAX_DIGITS, "digits"));
+
+      Secret secret = Secret::fromBase32(source.secret);
+      const SecureKey &bytes = secret.getBytes();
+      if (bytes.empty()) {
+        throw std::runtime_error("Secret is empty");
+      }
+      if (bytes.size() > KeyVault::MAX_KEY_SIZE) {
+        throw std::runtime_error(
+            "Key vault secrets are limited to 64 bytes");
+      }
+      record.keySize = static_cast<uint8_t>(bytes.size());
+      std::memcpy(record.key, bytes.data(), bytes.size());
+    }
+  } catch (...) {
+    // Records already filled in hold decoded key bytes.
+    SecureMemory::wipe(vaultRecords.data(),
+                       vaultRecords.size() * sizeof(KeyVault::Record));
+    throw;
+  }
+  KeyVault::write(path, std::move(vaultRecords));
+}
+
+std::shared_ptr<HybridNitroSecret> HybridNitroSecret::self() {
+  return std::dynamic_pointer_cast<HybridNitroSecret>(shared_from_this());
+}
+
 } // namespace margelo::nitro::totp
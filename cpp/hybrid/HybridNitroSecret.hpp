@@ -1,6 +1,10 @@
 #pragma once
 
 #include "HybridNitroSecretSpec.hpp"
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
 
 namespace margelo::nitro::totp {
 
@@ -11,9 +15,41 @@ public:
 public:
   std::string generate(const GenerateSecretKeyOptions &options) override;
 
+  std::shared_ptr<Promise<std::string>>
+  generateAsync(const GenerateSecretKeyOptions &options) override;
+
+  std::vector<std::string>
+  generateMany(double count, const GenerateSecretKeyOptions &options) override;
+
+  std::shared_ptr<Promise<std::vector<std::string>>>
+  generateManyAsync(double count,
+                    const GenerateSecretKeyOptions &options) override;
+
+  std::shared_ptr<ArrayBuffer>
+  generateBytes(const GenerateSecretKeyOptions &options) override;
+
+  std::shared_ptr<HybridNitroTotpKeySpec>
+  createKey(const std::variant<std::string, std::shared_ptr<ArrayBuffer>>
+                &secret,
+            SupportedAlgorithm algorithm) override;
+
+  std::shared_ptr<HybridNitroKeyVaultSpec>
+  openVault(const std::string &path) override;
+
+  // Throws for invalid records, leaving any existing vault at `path` intact.
+  void writeVault(const std::string &path,
+                  const std::vector<NitroKeyVaultRecord> &records) override;
+
   void loadHybridMethods() override {
     // call base protoype
     HybridNitroSecretSpec::loadHybridMethods();
   }
+
+  // Upper bound for generateMany, which holds all secrets in memory at once.
+  static constexpr size_t MAX_GENERATE_MANY = 1000000;
+
+private:
+  // Keeps this object alive while a task queued by an *Async method runs.
+  std::shared_ptr<HybridNitroSecret> self();
 };
 } // namespace margelo::nitro::totp
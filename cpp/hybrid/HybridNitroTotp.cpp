@@ -1,46 +1,386 @@
 #include "HybridNitroTotp.hpp"
+#include "AsyncTask.hpp"
 #include "../core/Hmac.hpp"
+#include "../core/Hotp.hpp"
+#include "../core/KeyCache.hpp"
+#include "../core/ReplayStore.hpp"
 #include "../core/Secret.hpp"
 #include "../utils/BaseOptions.hpp"
+#include "../utils/ThreadPool.hpp"
+#include "../utils/TotpScheduler.hpp"
 #include "../utils/Utils.hpp"
-#include "HybridNitroHotp.hpp"
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 
 namespace margelo::nitro::totp {
 
-std::string HybridNitroTotp::generate(const std::string &secret,
+// The key handle's precomputed code of `counter`, if it has a ring for this
+// period and digit count.
+static std::optional<uint32_t> getPrecomputed(const SecretOrKey &secret,
+                                              int period, int digits,
+                                              uint64_t counter) {
+  const auto *handle =
+      std::get_if<std::shared_ptr<HybridNitroTotpKeySpec>>(&secret);
+  if (!handle) {
+    return std::nullopt;
+  }
+  auto *key = dynamic_cast<HybridNitroTotpKey *>(handle->get());
+  if (!key) {
+    return std::nullopt;
+  }
+  return key->getPrecomputed(static_cast<uint64_t>(period), digits, counter);
+}
+
+std::string HybridNitroTotp::generate(const SecretOrKey &secret,
                                       const NitroTotpGenerateOptions &options) {
   int period = options.period.value();
   int digits = options.digits.value();
-  SupportedAlgorithm algorithm = options.algorithm.value();
+  HMAC::Algorithm algorithm =
+      Utils::getHmacAlgorithm(options.algorithm.value());
   uint64_t currentTime = static_cast<uint64_t>(options.currentTime.value());
 
   uint64_t counter = static_cast<uint64_t>(currentTime) / period;
 
-  NitroHotpGenerateOptions generateOptions(counter, digits, algorithm);
+  // Precomputed codes turn the common case into a few atomic operations.
+  if (std::optional<uint32_t> otp =
+          getPrecomputed(secret, period, digits, counter)) {
+    return Utils::formatOtp(*otp, digits);
+  }
+
+  return Utils::generateOtp(secret, algorithm, counter, digits);
+}
+
+void HybridNitroTotp::precompute(
+    const std::shared_ptr<HybridNitroTotpKeySpec> &key, double count,
+    const NitroTotpGenerateOptions &options) {
+  auto handle = std::dynamic_pointer_cast<HybridNitroTotpKey>(key);
+  if (!handle) {
+    throw std::runtime_error("Invalid NitroTotpKey");
+  }
+  int period = options.period.value();
+  int digits = options.digits.value();
+  uint64_t currentTime = static_cast<uint64_t>(options.currentTime.value());
+  if (period <= 0) {
+    throw std::runtime_error("Invalid period");
+  }
+  if (!(count >= 1 && count <= CodeRing::MAX_CAPACITY)) {
+    throw std::runtime_error("Invalid count");
+  }
 
-  HybridNitroHotp hybridNitroHotp;
+  std::shared_ptr<const CodeRing> ring = handle->useCodeRing(
+      static_cast<uint64_t>(period), digits, static_cast<size_t>(count));
+  ring->fill(currentTime / period);
+}
+
+std::vector<std::string>
+HybridNitroTotp::generateMany(const std::vector<std::string> &secrets,
+                              const NitroTotpGenerateOptions &options) {
+  int period = options.period.value();
+  int digits = options.digits.value();
+  HMAC::Algorithm algorithm =
+      Utils::getHmacAlgorithm(options.algorithm.value());
+  uint64_t currentTime = static_cast<uint64_t>(options.currentTime.value());
+
+  uint64_t counter = static_cast<uint64_t>(currentTime) / period;
 
-  return hybridNitroHotp.generate(secret, generateOptions);
+  return Utils::generateOtps(secrets, algorithm, counter, digits);
 }
 
-bool HybridNitroTotp::validate(const std::string &secret,
+bool HybridNitroTotp::validate(const SecretOrKey &secret,
+                               const std::string &otp,
+                               const NitroTotpValidateOptions &options) {
+  return validateDelta(secret, otp, options).has_value();
+}
+
+// Replay records are keyed by the handle's id, so they hold no secret data
+// and cannot be confused by keys being rebuilt in the key cache.
+static uint64_t getReplayId(const SecretOrKey &secret) {
+  const auto *handle =
+      std::get_if<std::shared_ptr<HybridNitroTotpKeySpec>>(&secret);
+  auto key = handle ? std::dynamic_pointer_cast<HybridNitroTotpKey>(*handle)
+                    : nullptr;
+  if (!key) {
+    throw std::runtime_error("Replay protection requires a NitroTotpKey");
+  }
+  return key->getId();
+}
+
+std::optional<double>
+HybridNitroTotp::validateDelta(const SecretOrKey &secret,
                                const std::string &otp,
                                const NitroTotpValidateOptions &options) {
 
   // Default values
   int period = options.period.value();
   int digits = options.digits.value();
-  SupportedAlgorithm algorithm = options.algorithm.value();
-  int window = options.window.value();
+  HMAC::Algorithm algorithm =
+      Utils::getHmacAlgorithm(options.algorithm.value());
+  int window = Utils::getWindow(options.window.value());
   uint64_t currentTime = static_cast<uint64_t>(options.currentTime.value());
+  bool constantTime = options.constantTime.value_or(false);
+  bool replayProtection = options.replayProtection.value_or(false);
+
+  uint64_t replayId = replayProtection ? getReplayId(secret) : 0;
 
   uint64_t counter = static_cast<uint64_t>(currentTime) / period;
 
-  NitroHotpValidateOptions validateOptions(counter, window, digits, algorithm);
+  std::optional<int> delta = Utils::findOtp(
+      secret, otp, algorithm, counter, window, digits, false, constantTime);
+  if (!delta) {
+    return std::nullopt;
+  }
+  if (!replayProtection) {
+    return static_cast<double>(*delta);
+  }
+
+  // The matched step stays inside some future window until the clock moves
+  // `window` steps past it; after that the record can be swept.
+  uint64_t step = counter + static_cast<int64_t>(*delta);
+  uint64_t expiresAt = (step + window + 1) * static_cast<uint64_t>(period);
+  if (!ReplayStore::shared().accept(replayId, step, currentTime, expiresAt)) {
+    return std::nullopt;
+  }
+  return static_cast<double>(*delta);
+}
+
+std::shared_ptr<ArrayBuffer>
+HybridNitroTotp::validateMany(const std::vector<SecretOrKey> &secrets,
+                              const std::vector<std::string> &otps,
+                              const NitroTotpValidateOptions &options) {
+  if (secrets.size() != otps.size()) {
+    throw std::runtime_error("Expected one code per secret");
+  }
+  int period = options.period.value();
+  int digits = options.digits.value();
+  HMAC::Algorithm algorithm =
+      Utils::getHmacAlgorithm(options.algorithm.value());
+  int window = Utils::getWindow(options.window.value());
+  uint64_t currentTime = static_cast<uint64_t>(options.currentTime.value());
+  bool replayProtection = options.replayProtection.value_or(false);
+  if (period <= 0) {
+    throw std::runtime_error("Invalid period");
+  }
+
+  // The time step is shared by the whole batch.
+  uint64_t counter = currentTime / period;
+  size_t count = secrets.size();
+
+  std::vector<uint64_t> replayIds;
+  if (replayProtection) {
+    replayIds.reserve(count);
+    for (const SecretOrKey &secret : secrets) {
+      replayIds.push_back(getReplayId(secret));
+    }
+  }
+
+  // Codes that do not parse can never match, so their keys are not even
+  // prepared. Handles and raw bytes are resolved here, since ArrayBuffers
+  // from JS may only be read on this thread; strings are decoded by the
+  // workers. An entry whose secret cannot be keyed (empty, or no Base32 in
+  // it) is left without a key and reported as NO_MATCH, so it does not fail
+  // the rest of the batch.
+  std::vector<std::shared_ptr<const HMAC::Key>> keys(count);
+  std::vector<uint32_t> expected(count);
+  std::vector<bool> parsed(count);
+  for (size_t i = 0; i < count; ++i) {
+    parsed[i] = HOTP::parse(otps[i], digits, expected[i]);
+    if (parsed[i] && !std::holds_alternative<std::string>(secrets[i])) {
+      try {
+        keys[i] = Utils::getKey(secrets[i], algorithm);
+      } catch (const std::runtime_error &) {
+      }
+    }
+  }
+
+  std::shared_ptr<ArrayBuffer> result =
+      ArrayBuffer::allocate(count * sizeof(int32_t));
+  int32_t *deltas = reinterpret_cast<int32_t *>(result->data());
+
+  // Entries per task: enough candidates to keep every multi-buffer lane
+  // busy, few enough that a burst spreads over all workers.
+  constexpr size_t PART_SIZE = 256;
+  size_t parts = (count + PART_SIZE - 1) / PART_SIZE;
+  ThreadPool::shared().parallelFor(parts, [&](size_t part) {
+    size_t begin = part * PART_SIZE;
+    size_t end = std::min(count, begin + PART_SIZE);
+    for (size_t i = begin; i < end; ++i) {
+      if (parsed[i] && std::holds_alternative<std::string>(secrets[i])) {
+        try {
+          keys[i] = KeyCache::prepare(std::get<std::string>(secrets[i]),
+                                      algorithm);
+        } catch (const std::runtime_error &) {
+        }
+      }
+    }
+
+    // Group entries by algorithm so each batch feeds a single kernel.
+    std::vector<size_t> order;
+    order.reserve(end - begin);
+    for (HMAC::Algorithm group : {HMAC::Algorithm::SHA1,
+                                  HMAC::Algorithm::SHA256,
+                                  HMAC::Algorithm::SHA512}) {
+      for (size_t i = begin; i < end; ++i) {
+        if (keys[i] && keys[i]->getAlgorithm() == group) {
+          order.push_back(i);
+        }
+      }
+    }
+    std::vector<const HMAC::Key *> groupKeys(order.size());
+    std::vector<uint32_t> groupOtps(order.size());
+    std::vector<int32_t> groupDeltas(order.size());
+    for (size_t j = 0; j < order.size(); ++j) {
+      groupKeys[j] = keys[order[j]].get();
+      groupOtps[j] = expected[order[j]];
+    }
+    HOTP::findMany(groupKeys.data(), groupOtps.data(), order.size(), counter,
+                   window, digits, groupDeltas.data());
+
+    std::fill(deltas + begin, deltas + end, HOTP::NO_MATCH);
+    for (size_t j = 0; j < order.size(); ++j) {
+      deltas[order[j]] = groupDeltas[j];
+    }
+  });
+
+  // In input order, so a code repeated within the batch is accepted once.
+  if (replayProtection) {
+    for (size_t i = 0; i < count; ++i) {
+      if (deltas[i] == HOTP::NO_MATCH) {
+        continue;
+      }
+      uint64_t step = counter + static_cast<int64_t>(deltas[i]);
+      uint64_t expiresAt = (step + window + 1) * static_cast<uint64_t>(period);
+      if (!ReplayStore::shared().accept(replayIds[i], step, currentTime,
+                                        expiresAt)) {
+        deltas[i] = HOTP::NO_MATCH;
+      }
+    }
+  }
+  return result;
+}
+
+NitroKeyCacheStats HybridNitroTotp::getKeyCacheStats() {
+  return Utils::toNitroKeyCacheStats(KeyCache::shared().getStats());
+}
+
+void HybridNitroTotp::clearKeyCache() { KeyCache::shared().clear(); }
+
+double HybridNitroTotp::subscribe(
+    const std::vector<std::shared_ptr<HybridNitroTotpKeySpec>> &keys,
+    const std::vector<double> &periods, double digits,
+    const std::function<void(const std::vector<NitroTotpCodeUpdate> &)>
+        &onUpdate) {
+  if (keys.empty()) {
+    throw std::runtime_error("Expected at least one key");
+  }
+  // One period applies to every key; otherwise periods pair up with keys.
+  if (periods.size() != 1 && periods.size() != keys.size()) {
+    throw std::runtime_error("Expected one period or one period per key");
+  }
+
+  std::vector<TotpScheduler::Entry> entries;
+  entries.reserve(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    auto key = std::dynamic_pointer_cast<HybridNitroTotpKey>(keys[i]);
+    if (!key) {
+      throw std::runtime_error("Invalid NitroTotpKey");
+    }
+    double period = periods.size() == 1 ? periods[0] : periods[i];
+    if (!(period >= 1 &&
+          period <= static_cast<double>(TotpScheduler::MAX_PERIOD))) {
+      throw std::runtime_error("Invalid period");
+    }
+    entries.push_back({key->getKey(), static_cast<uint64_t>(period)});
+  }
+
+  // Checked in double first: casting NaN, infinities or values out of range
+  // to an integer is undefined.
+  if (!std::isfinite(digits) || digits != std::floor(digits) ||
+      digits < HOTP::MIN_DIGITS || digits > HOTP::MAX_DIGITS) {
+    throw std::runtime_error("Invalid digits");
+  }
+  int codeDigits = static_cast<int>(digits);
+  auto listener = [onUpdate, codeDigits](
+                      const std::vector<TotpScheduler::Update> &updates) {
+    std::vector<NitroTotpCodeUpdate> result;
+    result.reserve(updates.size());
+    for (const TotpScheduler::Update &update : updates) {
+      result.emplace_back(static_cast<double>(update.index),
+                          Utils::formatOtp(update.otp, codeDigits),
+                          static_cast<double>(update.secondsRemaining));
+    }
+    onUpdate(result);
+  };
+  uint64_t id = TotpScheduler::shared().subscribe(std::move(entries),
+                                                  codeDigits, listener);
+  return static_cast<double>(id);
+}
+
+void HybridNitroTotp::unsubscribe(double subscriptionId) {
+  // Ids are integers below 2^64; anything else names no subscription.
+  if (!std::isfinite(subscriptionId) || subscriptionId < 0.0 ||
+      subscriptionId >= 18446744073709551616.0 ||
+      subscriptionId != std::floor(subscriptionId)) {
+    return;
+  }
+  TotpScheduler::shared().unsubscribe(static_cast<uint64_t>(subscriptionId));
+}
+
+std::shared_ptr<Promise<std::string>>
+HybridNitroTotp::generateAsync(const SecretOrKey &secret,
+                               const NitroTotpGenerateOptions &options) {
+  return runAsync<std::string>(
+      [self = self(), secret = Utils::toOwned(secret), options]() {
+        return self->generate(secret, options);
+      });
+}
+
+std::shared_ptr<Promise<std::vector<std::string>>>
+HybridNitroTotp::generateManyAsync(const std::vector<std::string> &secrets,
+                                   const NitroTotpGenerateOptions &options) {
+  return runAsync<std::vector<std::string>>(
+      [self = self(), secrets, options]() {
+        return self->generateMany(secrets, options);
+      });
+}
+
+std::shared_ptr<Promise<bool>>
+HybridNitroTotp::validateAsync(const SecretOrKey &secret,
+                               const std::string &otp,
+                               const NitroTotpValidateOptions &options) {
+  return runAsync<bool>(
+      [self = self(), secret = Utils::toOwned(secret), otp, options]() {
+        return self->validate(secret, otp, options);
+      });
+}
+
+std::shared_ptr<Promise<std::optional<double>>>
+HybridNitroTotp::validateDeltaAsync(const SecretOrKey &secret,
+                                    const std::string &otp,
+                                    const NitroTotpValidateOptions &options) {
+  return runAsync<std::optional<double>>(
+      [self = self(), secret = Utils::toOwned(secret), otp, options]() {
+        return self->validateDelta(secret, otp, options);
+      });
+}
+
+std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>>
+HybridNitroTotp::validateManyAsync(const std::vector<SecretOrKey> &secrets,
+                                   const std::vector<std::string> &otps,
+                                   const NitroTotpValidateOptions &options) {
+  std::vector<SecretOrKey> owned;
+  owned.reserve(secrets.size());
+  for (const SecretOrKey &secret : secrets) {
+    owned.push_back(Utils::toOwned(secret));
+  }
+  return runAsync<std::shared_ptr<ArrayBuffer>>(
+      [self = self(), secrets = std::move(owned), otps, options]() {
+        return self->validateMany(secrets, otps, options);
+      });
+}
 
-  HybridNitroHotp hybridNitroHotp;
-  return hybridNitroHotp.validate(secret, otp, validateOptions);
+std::shared_ptr<HybridNitroTotp> HybridNitroTotp::self() {
+  return std::dynamic_pointer_cast<HybridNitroTotp>(shared_from_this());
 }
 
 } // namespace margelo::nitro::totp
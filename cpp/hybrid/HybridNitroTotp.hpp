@@ -1,7 +1,11 @@
 #pragma once
 
+#include "HybridNitroTotpKey.hpp"
 #include "HybridNitroTotpSpec.hpp"
+#include <functional>
+#include <optional>
 #include <string>
+#include <vector>
 
 namespace margelo::nitro::totp {
 
@@ -10,15 +14,69 @@ public:
   HybridNitroTotp() : HybridObject(TAG) {}
 
 public:
-  std::string generate(const std::string &secret,
+  std::string generate(const SecretOrKey &secret,
                        const NitroTotpGenerateOptions &options) override;
 
-  bool validate(const std::string &secret, const std::string &otp,
+  std::shared_ptr<Promise<std::string>>
+  generateAsync(const SecretOrKey &secret,
+                const NitroTotpGenerateOptions &options) override;
+
+  std::vector<std::string>
+  generateMany(const std::vector<std::string> &secrets,
+               const NitroTotpGenerateOptions &options) override;
+
+  std::shared_ptr<Promise<std::vector<std::string>>>
+  generateManyAsync(const std::vector<std::string> &secrets,
+                    const NitroTotpGenerateOptions &options) override;
+
+  bool validate(const SecretOrKey &secret, const std::string &otp,
+                const NitroTotpValidateOptions &options) override;
+
+  std::shared_ptr<Promise<bool>>
+  validateAsync(const SecretOrKey &secret, const std::string &otp,
+                const NitroTotpValidateOptions &options) override;
+
+  std::optional<double>
+  validateDelta(const SecretOrKey &secret, const std::string &otp,
                 const NitroTotpValidateOptions &options) override;
 
+  std::shared_ptr<Promise<std::optional<double>>>
+  validateDeltaAsync(const SecretOrKey &secret, const std::string &otp,
+                     const NitroTotpValidateOptions &options) override;
+
+  std::shared_ptr<ArrayBuffer>
+  validateMany(const std::vector<SecretOrKey> &secrets,
+               const std::vector<std::string> &otps,
+               const NitroTotpValidateOptions &options) override;
+
+  std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>>
+  validateManyAsync(const std::vector<SecretOrKey> &secrets,
+                    const std::vector<std::string> &otps,
+                    const NitroTotpValidateOptions &options) override;
+
+  NitroKeyCacheStats getKeyCacheStats() override;
+
+  void clearKeyCache() override;
+
+  double subscribe(
+      const std::vector<std::shared_ptr<HybridNitroTotpKeySpec>> &keys,
+      const std::vector<double> &periods, double digits,
+      const std::function<void(const std::vector<NitroTotpCodeUpdate> &)>
+          &onUpdate) override;
+
+  void unsubscribe(double subscriptionId) override;
+
+  void precompute(const std::shared_ptr<HybridNitroTotpKeySpec> &key,
+                  double count,
+                  const NitroTotpGenerateOptions &options) override;
+
   void loadHybridMethods() override {
     // call base protoype
     HybridNitroTotpSpec::loadHybridMethods();
   }
+
+private:
+  // Keeps this object alive while a task queued by an *Async method runs.
+  std::shared_ptr<HybridNitroTotp> self();
 };
 } // namespace margelo::nitro::totp
@@ -0,0 +1,35 @@
+#include "HybridNitroTotpKey.hpp"
+#include <atomic>
+
+namespace margelo::nitro::totp {
+
+SupportedAlgorithm HybridNitroTotpKey::getAlgorithm() { return algorithm; }
+
+const std::shared_ptr<const HMAC::Key> &HybridNitroTotpKey::getKey() const {
+  return key;
+}
+
+uint64_t HybridNitroTotpKey::getId() const { return id; }
+
+std::optional<uint32_t>
+HybridNitroTotpKey::getPrecomputed(uint64_t period, int digits,
+                                   uint64_t counter) const {
+  return codeRing.get(period, digits, counter);
+}
+
+std::shared_ptr<const CodeRing>
+HybridNitroTotpKey::useCodeRing(uint64_t period, int digits,
+                                size_t capacity) {
+  return codeRing.use(key, period, digits, capacity);
+}
+
+uint64_t HybridNitroTotpKey::nextId() {
+  static std::atomic<uint64_t> counter(0);
+  return ++counter;
+}
+
+size_t HybridNitroTotpKey::getExternalMemorySize() noexcept {
+  return sizeof(HMAC::Key) + codeRing.memorySize();
+}
+
+} // namespace margelo::nitro::totp
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "../core/Hmac.hpp"
+#include "../utils/CodeRing.hpp"
+#include "HybridNitroTotpKeySpec.hpp"
+#include <NitroModules/ArrayBuffer.hpp>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace margelo::nitro::totp {
+
+// Secret argument accepted by generate/validate: a Base32 string, a handle or
+// raw key bytes.
+using SecretOrKey =
+    std::variant<std::string, std::shared_ptr<HybridNitroTotpKeySpec>,
+                 std::shared_ptr<ArrayBuffer>>;
+
+// Native handle to a prepared HMAC key. Only the precomputed inner/outer
+// state is kept; the decoded secret is wiped as soon as the key is built.
+class HybridNitroTotpKey : public HybridNitroTotpKeySpec {
+public:
+  HybridNitroTotpKey(std::shared_ptr<const HMAC::Key> key,
+                     SupportedAlgorithm algorithm)
+      : HybridObject(TAG), key(std::move(key)), algorithm(algorithm),
+        id(nextId()) {}
+
+public:
+  SupportedAlgorithm getAlgorithm() override;
+
+  const std::shared_ptr<const HMAC::Key> &getKey() const;
+
+  // Process-unique, never reused, and never 0; identifies the key in the
+  // replay store without keeping any secret-derived data there.
+  uint64_t getId() const;
+
+  // Lock-free. The precomputed code of `counter`, if the key's ring was
+  // built for `period` and `digits` and holds that step.
+  std::optional<uint32_t> getPrecomputed(uint64_t period, int digits,
+                                         uint64_t counter) const;
+
+  // Returns the key's ring, replacing it with a new one for `period` and
+  // `digits` holding `capacity` codes unless it already matches. A key
+  // holds one ring at a time, so its memory stays bounded however often
+  // the parameters change.
+  std::shared_ptr<const CodeRing> useCodeRing(uint64_t period, int digits,
+                                              size_t capacity);
+
+  size_t getExternalMemorySize() noexcept override;
+
+  void loadHybridMethods() override {
+    // call base protoype
+    HybridNitroTotpKeySpec::loadHybridMethods();
+  }
+
+private:
+  std::shared_ptr<const HMAC::Key> key;
+  SupportedAlgorithm algorithm;
+  uint64_t id;
+  SharedCodeRing codeRing;
+
+  static uint64_t nextId();
+};
+} // namespace margelo::nitro::totp
@@ -0,0 +1,125 @@
+#include "Base32.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Character at a time, with the documented rules: case-insensitive, stops
+// at '=' or NUL and skips anything outside the alphabet.
+std::vector<uint8_t> referenceDecode(const std::string &input) {
+  std::vector<uint8_t> out;
+  uint32_t buffer = 0;
+  int bitsLeft = 0;
+  for (char ch : input) {
+    if (ch == '=' || ch == '\0') {
+      break;
+    }
+    int value;
+    if (ch >= 'A' && ch <= 'Z') {
+      value = ch - 'A';
+    } else if (ch >= 'a' && ch <= 'z') {
+      value = ch - 'a';
+    } else if (ch >= '2' && ch <= '7') {
+      value = ch - '2' + 26;
+    } else {
+      continue;
+    }
+    buffer = (buffer << 5) | static_cast<uint32_t>(value);
+    bitsLeft += 5;
+    if (bitsLeft >= 8) {
+      bitsLeft -= 8;
+      out.push_back(static_cast<uint8_t>(buffer >> bitsLeft));
+      buffer &= (1u << bitsLeft) - 1;
+    }
+  }
+  return out;
+}
+
+void expectDecodes(const std::string &input) {
+  EXPECT_EQ(Base32::decode(input), referenceDecode(input))
+      << "input \"" << input << "\" (" << input.size() << " chars)";
+}
+
+} // namespace
+
+TEST(Base32, EncodeRoundTrips) {
+  for (size_t size = 0; size <= 70; ++size) {
+    std::vector<uint8_t> bytes(size);
+    for (size_t i = 0; i < size; ++i) {
+      bytes[i] = static_cast<uint8_t>(i * 37 + size);
+    }
+    std::string padded = Base32::encode(bytes);
+    EXPECT_EQ(padded.size(), Base32::encodedSize(size, true));
+    EXPECT_EQ(Base32::decode(padded), bytes);
+
+    std::string unpadded(Base32::encodedSize(size, false), '\0');
+    unpadded.resize(
+        Base32::encode(bytes.data(), size, unpadded.data(), false));
+    EXPECT_EQ(unpadded, Base32::clean(padded));
+    EXPECT_EQ(Base32::decode(unpadded), bytes);
+  }
+}
+
+TEST(Base32, DecodesMixedCaseAndSeparators) {
+  expectDecodes("JBSWY3DPEHPK3PXP");
+  expectDecodes("jbswy3dpehpk3pxp");
+  expectDecodes("JbSw Y3dP-eHpK 3pXp");
+  expectDecodes("jbsw y3dp ehpk 3pxp jbsw y3dp ehpk 3pxp");
+  expectDecodes("JBSWY3DPEHPK3PX\x80JBSWY3DPEHPK3PXP");
+  expectDecodes("JBSWY3DP01890189EHPK3PXPJBSWY3DPEHPK3PXP");
+}
+
+TEST(Base32, StopsAtPaddingAndNul) {
+  expectDecodes("JBSWY3DPEHPK3PXP=JBSWY3DPEHPK3PXP");
+  expectDecodes("JBSWY3DPEHPK3P==JBSWY3DPEHPK3PXP");
+  expectDecodes(std::string("JBSWY3DPEHPK3PXPJBSW\0Y3DPEHPK3PXPJBSW", 37));
+  expectDecodes(std::string("\0JBSWY3DPEHPK3PXPJBSWY3DP", 25));
+  expectDecodes("=JBSWY3DPEHPK3PXPJBSWY3DP");
+}
+
+// The 16-character fast path only runs on a byte boundary. Shifting a long
+// run by 1..15 leading characters, and breaking it with a skipped character
+// at every position, enters and leaves it at every offset.
+TEST(Base32, FastPathBoundaries) {
+  const std::string run = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567abcdefghijklmnop"
+                          "qrstuvwxyz234567ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+  for (size_t lead = 0; lead < 16; ++lead) {
+    for (size_t length = 0; length + lead <= run.size(); ++length) {
+      expectDecodes(run.substr(0, lead) + run.substr(lead, length));
+    }
+    for (size_t at = 0; at <= 40; ++at) {
+      std::string input = run.substr(0, lead) + run.substr(lead, 40);
+      for (const char *separator : {" ", "-", "=", "1"}) {
+        std::string broken = input;
+        broken.insert(std::min(at, broken.size()), separator);
+        expectDecodes(broken);
+      }
+      std::string withNul = input;
+      withNul.insert(std::min(at, withNul.size()), 1, '\0');
+      expectDecodes(withNul);
+    }
+  }
+}
+
+TEST(Base32, MatchesReferenceOnRandomInput) {
+  const std::string pool = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567"
+                           "abcdefghijklmnopqrstuvwxyz"
+                           "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567"
+                           " -0189@[`{\x80\xff";
+  std::mt19937 rng(20240611);
+  for (int round = 0; round < 20000; ++round) {
+    size_t size = rng() % 96;
+    std::string input(size, 'A');
+    for (char &ch : input) {
+      ch = pool[rng() % pool.size()];
+    }
+    if (size > 0 && rng() % 8 == 0) {
+      input[rng() % size] = rng() % 2 ? '=' : '\0';
+    }
+    expectDecodes(input);
+  }
+}
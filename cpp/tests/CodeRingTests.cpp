@@ -0,0 +1,177 @@
+#include "CodeRing.hpp"
+#include "Hotp.hpp"
+#include "KeyCache.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using margelo::nitro::totp::CodeRing;
+using margelo::nitro::totp::SharedCodeRing;
+
+namespace {
+
+constexpr int DIGITS = 6;
+
+std::shared_ptr<const HMAC::Key> testKey() {
+  // RFC 4226 test secret "12345678901234567890".
+  return KeyCache::prepare("GEZDGNBVGY3TQOJQGEZDGNBVGY3TQOJQ",
+                           HMAC::Algorithm::SHA1);
+}
+
+// Background refills run on the shared pool; poll until `counter` shows up.
+bool waitForCode(const CodeRing &ring, uint64_t counter) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (std::chrono::steady_clock::now() < deadline) {
+    if (ring.get(counter)) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return false;
+}
+
+} // namespace
+
+TEST(CodeRing, FillThenGetMatchesCompute) {
+  auto key = testKey();
+  auto ring = std::make_shared<CodeRing>(key, 30, DIGITS, 8);
+  EXPECT_FALSE(ring->get(100));
+
+  ring->fill(100);
+  for (uint64_t counter = 100; counter < 108; ++counter) {
+    std::optional<uint32_t> otp = ring->get(counter);
+    ASSERT_TRUE(otp) << counter;
+    EXPECT_EQ(*otp, HOTP::compute(*key, counter, DIGITS)) << counter;
+  }
+}
+
+TEST(CodeRing, WrapsAroundWithoutServingStaleSlots) {
+  auto key = testKey();
+  auto ring = std::make_shared<CodeRing>(key, 30, DIGITS, 8);
+  ring->fill(100);
+  ring->fill(105);
+  // 105 .. 112 now share slots with 97 .. 104; the old steps must miss.
+  for (uint64_t counter = 97; counter < 105; ++counter) {
+    EXPECT_FALSE(ring->get(counter)) << counter;
+  }
+  for (uint64_t counter = 105; counter < 113; ++counter) {
+    std::optional<uint32_t> otp = ring->get(counter);
+    ASSERT_TRUE(otp) << counter;
+    EXPECT_EQ(*otp, HOTP::compute(*key, counter, DIGITS)) << counter;
+  }
+}
+
+TEST(CodeRing, TopsUpAsTheCurrentStepMovesForward) {
+  auto key = testKey();
+  auto ring = std::make_shared<CodeRing>(key, 30, DIGITS, 8);
+  ring->fill(0);
+  // Five of eight codes are behind step 5, so a refill from 5 starts.
+  ASSERT_TRUE(ring->get(5));
+  ASSERT_TRUE(waitForCode(*ring, 12));
+  EXPECT_EQ(*ring->get(12), HOTP::compute(*key, 12, DIGITS));
+
+  // A miss just past the filled range also moves it forward.
+  auto fresh = std::make_shared<CodeRing>(key, 30, DIGITS, 8);
+  fresh->fill(0);
+  EXPECT_FALSE(fresh->get(10));
+  ASSERT_TRUE(waitForCode(*fresh, 10));
+}
+
+TEST(CodeRing, StrayLookupsDoNotEvictUpcomingCodes) {
+  auto key = testKey();
+  auto ring = std::make_shared<CodeRing>(key, 30, DIGITS, 8);
+  ring->fill(1000);
+  EXPECT_FALSE(ring->get(10));
+  EXPECT_FALSE(ring->get(991));
+  EXPECT_FALSE(ring->get(1013));
+  EXPECT_FALSE(ring->get(50000));
+  EXPECT_FALSE(ring->get(UINT64_MAX));
+
+  // Give a wrongly scheduled refill time to land.
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  for (uint64_t counter = 1000; counter < 1004; ++counter) {
+    EXPECT_TRUE(ring->get(counter)) << counter;
+  }
+}
+
+TEST(CodeRing, RejectsInvalidParameters) {
+  auto key = testKey();
+  EXPECT_THROW(CodeRing(nullptr, 30, DIGITS, 8), std::runtime_error);
+  EXPECT_THROW(CodeRing(key, 0, DIGITS, 8), std::runtime_error);
+  EXPECT_THROW(CodeRing(key, 30, 0, 8), std::runtime_error);
+  EXPECT_THROW(CodeRing(key, 30, 11, 8), std::runtime_error);
+  EXPECT_THROW(CodeRing(key, 30, DIGITS, 0), std::runtime_error);
+  EXPECT_THROW(CodeRing(key, 30, DIGITS, CodeRing::MAX_CAPACITY + 1),
+               std::runtime_error);
+}
+
+TEST(SharedCodeRing, SwapsRingsWhenParametersChange) {
+  auto key = testKey();
+  SharedCodeRing shared;
+  EXPECT_FALSE(shared.get(30, DIGITS, 100));
+  EXPECT_EQ(shared.memorySize(), 0u);
+
+  std::shared_ptr<const CodeRing> first = shared.use(key, 30, DIGITS, 8);
+  first->fill(100);
+  EXPECT_EQ(shared.use(key, 30, DIGITS, 8), first);
+  EXPECT_EQ(shared.get(30, DIGITS, 100), HOTP::compute(*key, 100, DIGITS));
+  EXPECT_FALSE(shared.get(60, DIGITS, 100));
+  EXPECT_FALSE(shared.get(30, 8, 100));
+
+  std::shared_ptr<const CodeRing> second = shared.use(key, 60, 8, 16);
+  EXPECT_NE(second, first);
+  second->fill(50);
+  EXPECT_FALSE(shared.get(30, DIGITS, 100));
+  EXPECT_EQ(shared.get(60, 8, 50), HOTP::compute(*key, 50, 8));
+  EXPECT_EQ(shared.memorySize(),
+            sizeof(CodeRing) + 16 * sizeof(uint64_t));
+}
+
+// Readers never stop, yet every swap has to finish, and no reader may see
+// a released ring (AddressSanitizer) or a code for other parameters.
+TEST(SharedCodeRing, SwapsCompleteUnderConstantReaders) {
+  auto key = testKey();
+  SharedCodeRing shared;
+  const uint32_t expected6 = HOTP::compute(*key, 100, 6);
+  const uint32_t expected8 = HOTP::compute(*key, 100, 8);
+
+  std::atomic<bool> stop{false};
+  std::atomic<int> started{0};
+  std::atomic<uint64_t> wrong{0};
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 2; ++t) {
+    readers.emplace_back([&, t]() {
+      int digits = t % 2 == 0 ? 6 : 8;
+      uint64_t period = t % 2 == 0 ? 30 : 60;
+      started.fetch_add(1);
+      while (!stop.load(std::memory_order_relaxed)) {
+        std::optional<uint32_t> otp = shared.get(period, digits, 100);
+        if (otp && *otp != (digits == 6 ? expected6 : expected8)) {
+          wrong.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+
+  while (started.load() < 2) {
+    std::this_thread::yield();
+  }
+  for (int swap = 0; swap < 200; ++swap) {
+    bool even = swap % 2 == 0;
+    std::shared_ptr<const CodeRing> ring =
+        shared.use(key, even ? 30 : 60, even ? 6 : 8, 8);
+    ring->fill(100);
+  }
+  stop = true;
+  for (std::thread &reader : readers) {
+    reader.join();
+  }
+
+  EXPECT_EQ(wrong.load(), 0u);
+}
@@ -0,0 +1,113 @@
+#include "Hex.hpp"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Character at a time, with the documented rules: either case, nothing
+// skipped.
+int referenceNibble(char ch) {
+  if (ch >= '0' && ch <= '9') {
+    return ch - '0';
+  }
+  if (ch >= 'a' && ch <= 'f') {
+    return ch - 'a' + 10;
+  }
+  if (ch >= 'A' && ch <= 'F') {
+    return ch - 'A' + 10;
+  }
+  return -1;
+}
+
+std::string referenceEncode(const std::vector<uint8_t> &bytes) {
+  static const char digits[] = "0123456789ABCDEF";
+  std::string out;
+  for (uint8_t byte : bytes) {
+    out.push_back(digits[byte >> 4]);
+    out.push_back(digits[byte & 15]);
+  }
+  return out;
+}
+
+std::vector<uint8_t> pattern(size_t size) {
+  std::vector<uint8_t> bytes(size);
+  for (size_t i = 0; i < size; ++i) {
+    bytes[i] = static_cast<uint8_t>(i * 37 + size);
+  }
+  return bytes;
+}
+
+Hex::Status decode(const std::string &input, std::vector<uint8_t> &out) {
+  out.assign(Hex::decodedSize(input.size()), 0);
+  return Hex::decode(input, out.data());
+}
+
+} // namespace
+
+// Lengths up to 64 bytes cover zero to four 16-byte SIMD blocks, each with
+// every tail length.
+TEST(Hex, MatchesScalarReference) {
+  for (size_t size = 0; size <= 64; ++size) {
+    std::vector<uint8_t> bytes = pattern(size);
+    std::string encoded(Hex::encodedSize(size), '\0');
+    Hex::encode(bytes.data(), size, encoded.data());
+    EXPECT_EQ(encoded, referenceEncode(bytes)) << "size " << size;
+
+    std::vector<uint8_t> decoded;
+    ASSERT_EQ(decode(encoded, decoded), Hex::Status::OK) << "size " << size;
+    EXPECT_EQ(decoded, bytes) << "size " << size;
+  }
+}
+
+TEST(Hex, DecodesMixedCase) {
+  for (size_t size = 0; size <= 64; ++size) {
+    std::vector<uint8_t> bytes = pattern(size);
+    std::string input = referenceEncode(bytes);
+    for (size_t i = 0; i < input.size(); ++i) {
+      if (i % 3 != 0 && input[i] >= 'A' && input[i] <= 'F') {
+        input[i] = static_cast<char>(input[i] - 'A' + 'a');
+      }
+    }
+    std::vector<uint8_t> decoded;
+    ASSERT_EQ(decode(input, decoded), Hex::Status::OK) << input;
+    EXPECT_EQ(decoded, bytes) << input;
+  }
+
+  std::vector<uint8_t> decoded;
+  ASSERT_EQ(decode("00ff7Fa0Bc", decoded), Hex::Status::OK);
+  EXPECT_EQ(decoded, (std::vector<uint8_t>{0x00, 0xFF, 0x7F, 0xA0, 0xBC}));
+}
+
+// Characters just outside each range, and bytes that are negative as signed
+// chars, must fail in a SIMD block as well as in the scalar tail.
+TEST(Hex, RejectsInvalidCharacterAtEveryPosition) {
+  const std::string invalid("/:@G`g \x80\xff\0", 10);
+  for (size_t size : {15, 16, 17, 32, 40}) {
+    const std::string valid = referenceEncode(pattern(size));
+    for (size_t at = 0; at < valid.size(); ++at) {
+      for (char ch : invalid) {
+        ASSERT_LT(referenceNibble(ch), 0);
+        std::string input = valid;
+        input[at] = ch;
+        std::vector<uint8_t> decoded;
+        EXPECT_EQ(decode(input, decoded), Hex::Status::INVALID_CHARACTER)
+            << "size " << size << ", position " << at << ", char "
+            << static_cast<int>(static_cast<unsigned char>(ch));
+      }
+    }
+  }
+}
+
+TEST(Hex, RejectsOddLength) {
+  for (size_t length = 1; length <= 129; length += 2) {
+    std::string input(length, 'A');
+    std::vector<uint8_t> decoded;
+    EXPECT_EQ(decode(input, decoded), Hex::Status::ODD_LENGTH) << length;
+  }
+  // The length is checked before any character.
+  std::vector<uint8_t> decoded;
+  EXPECT_EQ(decode("zz0", decoded), Hex::Status::ODD_LENGTH);
+  EXPECT_EQ(decode("", decoded), Hex::Status::OK);
+}
@@ -0,0 +1,90 @@
+#include "Hmac.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+const char *const ALGORITHM_NAMES[] = {"SHA1", "SHA256", "SHA512"};
+
+std::vector<uint8_t> counterBytes(uint64_t counter) {
+  std::vector<uint8_t> bytes(8);
+  for (int i = 7; i >= 0; --i) {
+    bytes[i] = static_cast<uint8_t>(counter);
+    counter >>= 8;
+  }
+  return bytes;
+}
+
+// Keys of every algorithm and of sizes around the block size, interleaved so
+// lane groups are flushed both full and partially filled.
+struct Batch {
+  std::vector<std::vector<uint8_t>> secrets;
+  std::vector<HMAC::Algorithm> algorithms;
+  std::vector<std::unique_ptr<HMAC::Key>> keys;
+  std::vector<const HMAC::Key *> pointers;
+  std::vector<uint64_t> counters;
+
+  explicit Batch(size_t count) {
+    const size_t sizes[] = {1, 20, 32, 63, 64, 65, 128, 200};
+    for (size_t i = 0; i < count; ++i) {
+      auto algorithm = static_cast<HMAC::Algorithm>((i * 7 / 3) % 3);
+      std::vector<uint8_t> secret(sizes[i % 8]);
+      for (size_t j = 0; j < secret.size(); ++j) {
+        secret[j] = static_cast<uint8_t>(i * 131 + j * 29 + 7);
+      }
+      keys.push_back(std::make_unique<HMAC::Key>(algorithm, secret.data(),
+                                                 secret.size()));
+      pointers.push_back(keys.back().get());
+      secrets.push_back(std::move(secret));
+      algorithms.push_back(algorithm);
+      counters.push_back(i * 0x9E3779B97F4A7C15ull);
+    }
+  }
+};
+
+} // namespace
+
+// Every lane count the kernel can see: empty, partial groups and several
+// full groups with a partial tail.
+TEST(HmacMultiBuffer, MatchesComputeCounter) {
+  const size_t lanes = HMAC::getLaneCount();
+  for (size_t count = 0; count <= 3 * lanes + 5; ++count) {
+    Batch batch(count);
+    std::vector<HMAC::Digest> digests(count);
+    HMAC::computeCounters(batch.pointers.data(), batch.counters.data(), count,
+                          digests.data());
+
+    for (size_t i = 0; i < count; ++i) {
+      HMAC::Digest expected;
+      batch.keys[i]->computeCounter(batch.counters[i], expected);
+      ASSERT_EQ(digests[i].size, expected.size) << "count " << count;
+      EXPECT_TRUE(std::equal(expected.bytes.begin(),
+                             expected.bytes.begin() + expected.size,
+                             digests[i].bytes.begin()))
+          << "count " << count << ", key " << i;
+    }
+  }
+}
+
+// Ties the prepared-key paths back to the one-shot reference HMAC.
+TEST(HmacMultiBuffer, MatchesOneShotHmac) {
+  const size_t count = 4 * HMAC::getLaneCount() + 3;
+  Batch batch(count);
+  std::vector<HMAC::Digest> digests(count);
+  HMAC::computeCounters(batch.pointers.data(), batch.counters.data(), count,
+                        digests.data());
+
+  for (size_t i = 0; i < count; ++i) {
+    std::vector<uint8_t> expected = HMAC::compute(
+        ALGORITHM_NAMES[static_cast<int>(batch.algorithms[i])],
+        batch.secrets[i], counterBytes(batch.counters[i]));
+    ASSERT_EQ(digests[i].size, expected.size());
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(),
+                           digests[i].bytes.begin()))
+        << "key " << i;
+  }
+}
@@ -0,0 +1,187 @@
+#include "Hotp.hpp"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// Truncated codes are below 2^31, so this never matches.
+constexpr uint32_t NEVER = UINT32_MAX;
+
+std::unique_ptr<HMAC::Key> randomKey(std::mt19937_64 &rng) {
+  auto algorithm = static_cast<HMAC::Algorithm>(rng() % 3);
+  std::vector<uint8_t> secret(1 + rng() % 80);
+  for (uint8_t &byte : secret) {
+    byte = static_cast<uint8_t>(rng());
+  }
+  return std::make_unique<HMAC::Key>(algorithm, secret.data(), secret.size());
+}
+
+// Windows around the 64-candidate chunks the searches hash in.
+int randomWindow(std::mt19937_64 &rng) {
+  const int windows[] = {0, 1, 2, 31, 32, 33, 63, 64, 100};
+  return rng() % 4 == 0 ? static_cast<int>(rng() % 200)
+                        : windows[rng() % std::size(windows)];
+}
+
+} // namespace
+
+// The constant-time scan has to report exactly what the early-exit scan
+// does: a match at the first or last candidate, one in between, or none.
+TEST(Hotp, FindConstantTimeMatchesFind) {
+  std::mt19937_64 rng(20240917);
+  for (int round = 0; round < 300; ++round) {
+    std::unique_ptr<HMAC::Key> key = randomKey(rng);
+    uint64_t counter = rng() >> (rng() % 64);
+    int window = randomWindow(rng);
+    int digits = 6 + static_cast<int>(rng() % 5);
+
+    const int offsets[] = {
+        -window, window,
+        static_cast<int>(rng() % (2 * window + 1)) - window};
+    for (int offset : offsets) {
+      uint32_t otp = HOTP::compute(*key, counter + offset, digits);
+      std::optional<int> expected =
+          HOTP::find(*key, counter, window, digits, otp);
+      // A closer candidate may share the code; none further away wins.
+      ASSERT_TRUE(expected) << "offset " << offset;
+      EXPECT_LE(std::abs(*expected), std::abs(offset));
+      EXPECT_EQ(HOTP::findConstantTime(*key, counter, window, digits, otp),
+                expected)
+          << "round " << round << ", window " << window << ", offset "
+          << offset;
+    }
+
+    uint32_t first = HOTP::compute(*key, counter, digits);
+    EXPECT_EQ(HOTP::findConstantTime(*key, counter, window, digits, first),
+              0);
+    EXPECT_FALSE(HOTP::find(*key, counter, window, digits, NEVER));
+    EXPECT_FALSE(
+        HOTP::findConstantTime(*key, counter, window, digits, NEVER));
+  }
+}
+
+// findMany packs candidates of consecutive entries into shared batches;
+// each entry must still get find()'s answer, and null keys NO_MATCH.
+TEST(Hotp, FindManyMatchesFind) {
+  std::mt19937_64 rng(20240918);
+  for (int round = 0; round < 40; ++round) {
+    size_t count = rng() % 24;
+    uint64_t counter = rng() >> (rng() % 64);
+    int window = randomWindow(rng);
+    int digits = 6 + static_cast<int>(rng() % 5);
+
+    std::vector<std::unique_ptr<HMAC::Key>> keys;
+    std::vector<const HMAC::Key *> pointers;
+    std::vector<uint32_t> otps;
+    for (size_t i = 0; i < count; ++i) {
+      keys.push_back(randomKey(rng));
+      int offset = static_cast<int>(rng() % (2 * window + 1)) - window;
+      switch (rng() % 5) {
+      case 0:
+        offset = -window;
+        break;
+      case 1:
+        offset = window;
+        break;
+      }
+      otps.push_back(rng() % 4 == 0
+                         ? NEVER
+                         : HOTP::compute(*keys.back(), counter + offset,
+                                         digits));
+      pointers.push_back(rng() % 8 == 0 ? nullptr : keys.back().get());
+    }
+
+    std::vector<int32_t> deltas(count, 0);
+    HOTP::findMany(pointers.data(), otps.data(), count, counter, window,
+                   digits, deltas.data());
+    for (size_t i = 0; i < count; ++i) {
+      std::optional<int> expected =
+          pointers[i] ? HOTP::find(*pointers[i], counter, window, digits,
+                                   otps[i])
+                      : std::nullopt;
+      EXPECT_EQ(deltas[i], expected ? *expected : HOTP::NO_MATCH)
+          << "round " << round << ", entry " << i;
+    }
+  }
+}
+
+// With one digit most codes occur several times in a window; every search
+// must return the match closest to the counter, the earlier one on a tie.
+TEST(Hotp, FindReturnsClosestMatch) {
+  std::mt19937_64 rng(20240920);
+  std::unique_ptr<HMAC::Key> key = randomKey(rng);
+  const int window = 20;
+  for (uint64_t counter : {uint64_t{1000}, uint64_t{5}, UINT64_MAX - 3}) {
+    for (uint32_t otp = 0; otp < 10; ++otp) {
+      std::optional<int> expected;
+      for (int distance = 0; distance <= window && !expected; ++distance) {
+        for (int offset : {-distance, distance}) {
+          if (!expected &&
+              HOTP::compute(*key, counter + offset, 1) == otp) {
+            expected = offset;
+          }
+        }
+      }
+      EXPECT_EQ(HOTP::find(*key, counter, window, 1, otp), expected) << otp;
+      EXPECT_EQ(HOTP::findConstantTime(*key, counter, window, 1, otp),
+                expected)
+          << otp;
+      const HMAC::Key *keys[] = {key.get()};
+      int32_t delta = 0;
+      HOTP::findMany(keys, &otp, 1, counter, window, 1, &delta);
+      EXPECT_EQ(delta, expected ? *expected : HOTP::NO_MATCH) << otp;
+    }
+  }
+}
+
+// Counters are 8-byte HMAC messages, so a window around 0 or UINT64_MAX
+// wraps instead of overflowing.
+TEST(Hotp, FindWrapsAroundTheCounterRange) {
+  std::mt19937_64 rng(20240921);
+  std::unique_ptr<HMAC::Key> key = randomKey(rng);
+  const int digits = 10;
+  for (uint64_t counter : {uint64_t{0}, uint64_t{1}, UINT64_MAX - 1,
+                           uint64_t{UINT64_MAX}}) {
+    for (int offset : {-3, -1, 0, 1, 3}) {
+      uint32_t otp = HOTP::compute(*key, counter + offset, digits);
+      EXPECT_EQ(HOTP::find(*key, counter, 3, digits, otp), offset)
+          << counter << " " << offset;
+      EXPECT_EQ(HOTP::findConstantTime(*key, counter, 3, digits, otp),
+                offset)
+          << counter << " " << offset;
+    }
+    uint32_t outside = HOTP::compute(*key, counter + 4, digits);
+    EXPECT_NE(HOTP::find(*key, counter, 3, digits, outside), 4);
+  }
+}
+
+TEST(Hotp, RejectsWindowsOutOfRange) {
+  std::mt19937_64 rng(20240922);
+  std::unique_ptr<HMAC::Key> key = randomKey(rng);
+  const HMAC::Key *keys[] = {key.get()};
+  uint32_t otp = 0;
+  int32_t delta = 0;
+  for (int window : {-1, HOTP::MAX_WINDOW + 1, INT32_MAX, INT32_MIN}) {
+    EXPECT_THROW(HOTP::find(*key, 100, window, 6, otp), std::runtime_error)
+        << window;
+    EXPECT_THROW(HOTP::findConstantTime(*key, 100, window, 6, otp),
+                 std::runtime_error)
+        << window;
+    EXPECT_THROW(HOTP::findMany(keys, &otp, 1, 100, window, 6, &delta),
+                 std::runtime_error)
+        << window;
+  }
+
+  // The largest window is accepted and its outermost candidates reached.
+  otp = HOTP::compute(*key, 100 + HOTP::MAX_WINDOW, 8);
+  std::optional<int> found = HOTP::find(*key, 100, HOTP::MAX_WINDOW, 8, otp);
+  ASSERT_TRUE(found);
+  EXPECT_LE(std::abs(*found), HOTP::MAX_WINDOW);
+}
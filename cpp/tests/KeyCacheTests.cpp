@@ -0,0 +1,116 @@
+#include "Base32.hpp"
+#include "Hotp.hpp"
+#include "KeyCache.hpp"
+#include "SecureKey.hpp"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+const std::string A = "JBSWY3DPEHPK3PXP";
+const std::string B = "GEZDGNBVGY3TQOJQ";
+const std::string C = "MFRGGZDFMZTWQ2LK";
+
+void expectStats(const KeyCache &cache, uint64_t hits, uint64_t misses,
+                 uint64_t evictions, size_t size) {
+  KeyCache::Stats stats = cache.getStats();
+  EXPECT_EQ(stats.hits, hits);
+  EXPECT_EQ(stats.misses, misses);
+  EXPECT_EQ(stats.evictions, evictions);
+  EXPECT_EQ(stats.size, size);
+}
+
+} // namespace
+
+TEST(KeyCache, EvictsLeastRecentlyUsed) {
+  KeyCache cache(2);
+  std::shared_ptr<const HMAC::Key> a = cache.get(A, HMAC::Algorithm::SHA1);
+  cache.get(B, HMAC::Algorithm::SHA1);
+  // A hit moves A to the front, so B is now the oldest entry.
+  EXPECT_EQ(cache.get(A, HMAC::Algorithm::SHA1), a);
+  expectStats(cache, 1, 2, 0, 2);
+
+  cache.get(C, HMAC::Algorithm::SHA1);
+  expectStats(cache, 1, 3, 1, 2);
+  EXPECT_EQ(cache.get(A, HMAC::Algorithm::SHA1), a);
+  expectStats(cache, 2, 3, 1, 2);
+  cache.get(B, HMAC::Algorithm::SHA1);
+  expectStats(cache, 2, 4, 2, 2);
+  // B pushed out C, the least recently used after A's hit.
+  cache.get(A, HMAC::Algorithm::SHA1);
+  expectStats(cache, 3, 4, 2, 2);
+  cache.get(C, HMAC::Algorithm::SHA1);
+  expectStats(cache, 3, 5, 3, 2);
+  EXPECT_EQ(cache.getStats().capacity, 2u);
+}
+
+// Each algorithm has its own prepared key, under a single entry.
+TEST(KeyCache, KeysEachAlgorithmSeparately) {
+  KeyCache cache(4);
+  std::shared_ptr<const HMAC::Key> sha1 = cache.get(A, HMAC::Algorithm::SHA1);
+  std::shared_ptr<const HMAC::Key> sha256 =
+      cache.get(A, HMAC::Algorithm::SHA256);
+  EXPECT_NE(sha1, sha256);
+  EXPECT_EQ(sha1->getAlgorithm(), HMAC::Algorithm::SHA1);
+  EXPECT_EQ(sha256->getAlgorithm(), HMAC::Algorithm::SHA256);
+  EXPECT_EQ(cache.get(A, HMAC::Algorithm::SHA256), sha256);
+  expectStats(cache, 1, 2, 0, 1);
+}
+
+// Clearing empties the cache but keeps the counters and the keys already
+// handed out.
+TEST(KeyCache, ClearDropsEntries) {
+  KeyCache cache(4);
+  std::shared_ptr<const HMAC::Key> a = cache.get(A, HMAC::Algorithm::SHA1);
+  cache.get(B, HMAC::Algorithm::SHA1);
+  cache.get(A, HMAC::Algorithm::SHA1);
+  cache.clear();
+  expectStats(cache, 1, 2, 0, 0);
+
+  std::shared_ptr<const HMAC::Key> again = cache.get(A, HMAC::Algorithm::SHA1);
+  EXPECT_NE(again, a);
+  expectStats(cache, 1, 3, 0, 1);
+  EXPECT_EQ(HOTP::compute(*a, 1, 8), HOTP::compute(*again, 1, 8));
+}
+
+TEST(KeyCache, ZeroCapacityNeverCaches) {
+  KeyCache cache(0);
+  std::shared_ptr<const HMAC::Key> first = cache.get(A, HMAC::Algorithm::SHA1);
+  EXPECT_NE(cache.get(A, HMAC::Algorithm::SHA1), first);
+  expectStats(cache, 0, 2, 0, 0);
+}
+
+TEST(KeyCache, SharedCacheIsOneInstance) {
+  EXPECT_EQ(&KeyCache::shared(), &KeyCache::shared());
+  EXPECT_EQ(KeyCache::shared().getStats().capacity, 64u);
+}
+
+// Secrets up to a slab slot are decoded on the stack, longer ones on the
+// heap; both must key the same bytes.
+TEST(KeyCache, PreparesSecretsAroundTheStackBufferSize) {
+  const size_t capacity = SecureKey::CAPACITY;
+  for (size_t size : {size_t{1}, capacity - 1, capacity, capacity + 1,
+                      size_t{200}}) {
+    std::vector<uint8_t> bytes(size);
+    for (size_t i = 0; i < size; ++i) {
+      bytes[i] = static_cast<uint8_t>(i * 13 + 5);
+    }
+    HMAC::Key expected(HMAC::Algorithm::SHA256, bytes.data(), bytes.size());
+    for (bool padded : {false, true}) {
+      std::string secret = Base32::encode(bytes);
+      if (!padded) {
+        secret = Base32::clean(secret);
+      }
+      std::shared_ptr<const HMAC::Key> key =
+          KeyCache::prepare(secret, HMAC::Algorithm::SHA256);
+      EXPECT_EQ(HOTP::compute(*key, 7, 8), HOTP::compute(expected, 7, 8))
+          << "size " << size;
+    }
+  }
+  EXPECT_THROW(KeyCache::prepare("", HMAC::Algorithm::SHA1),
+               std::runtime_error);
+}
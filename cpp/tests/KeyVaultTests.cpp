@@ -0,0 +1,257 @@
+#include "KeyVault.hpp"
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// A vault path in the temporary directory, removed again by the destructor.
+class TemporaryVault {
+public:
+  TemporaryVault() {
+    const testing::TestInfo *test =
+        testing::UnitTest::GetInstance()->current_test_info();
+    path = (std::filesystem::temp_directory_path() /
+            (std::string("nitrototp-") + test->name() + ".vault"))
+               .string();
+    std::remove(path.c_str());
+  }
+  ~TemporaryVault() { std::remove(path.c_str()); }
+
+  std::string path;
+};
+
+KeyVault::Record makeRecord(uint64_t id, uint8_t keySize = 20) {
+  KeyVault::Record record = {};
+  record.id = id;
+  record.counter = id * 3;
+  record.period = id % 2 == 0 ? 30 : 0;
+  record.algorithm = static_cast<uint8_t>(HMAC::Algorithm::SHA256);
+  record.digits = 6;
+  record.keySize = keySize;
+  for (uint8_t i = 0; i < keySize; ++i) {
+    record.key[i] = static_cast<uint8_t>(id + i);
+  }
+  return record;
+}
+
+std::vector<char> readFile(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  return std::vector<char>(std::istreambuf_iterator<char>(in), {});
+}
+
+void writeFile(const std::string &path, const std::vector<char> &bytes) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+// Overwrites the bytes at `offset` of the file with those of `value`.
+template <typename T>
+void patch(const std::string &path, size_t offset, const T &value) {
+  std::vector<char> bytes = readFile(path);
+  ASSERT_LE(offset + sizeof(T), bytes.size());
+  std::memcpy(bytes.data() + offset, &value, sizeof(T));
+  writeFile(path, bytes);
+}
+
+size_t recordOffset(size_t index) {
+  return sizeof(KeyVault::Header) + index * sizeof(KeyVault::Record);
+}
+
+} // namespace
+
+TEST(KeyVault, WriteThenOpenRoundTrips) {
+  TemporaryVault vault;
+  std::vector<KeyVault::Record> records = {makeRecord(7), makeRecord(3, 1),
+                                           makeRecord(11, 64)};
+  std::vector<KeyVault::Record> expected = {records[1], records[0],
+                                            records[2]};
+  KeyVault::write(vault.path, records);
+
+  EXPECT_EQ(readFile(vault.path).size(), recordOffset(3));
+  KeyVault opened(vault.path);
+  ASSERT_EQ(opened.size(), 3u);
+  for (size_t i = 0; i < expected.size(); ++i) {
+    const KeyVault::Record &record = opened.at(i);
+    EXPECT_EQ(record.id, expected[i].id);
+    EXPECT_EQ(record.counter, expected[i].counter);
+    EXPECT_EQ(record.period, expected[i].period);
+    EXPECT_EQ(record.algorithm, expected[i].algorithm);
+    EXPECT_EQ(record.digits, expected[i].digits);
+    ASSERT_EQ(record.keySize, expected[i].keySize);
+    EXPECT_EQ(std::memcmp(record.key, expected[i].key, record.keySize), 0);
+    EXPECT_NE(opened.prepareKey(i), nullptr);
+  }
+  EXPECT_THROW(opened.at(3), std::runtime_error);
+}
+
+TEST(KeyVault, EmptyVaultRoundTrips) {
+  TemporaryVault vault;
+  KeyVault::write(vault.path, {});
+  KeyVault opened(vault.path);
+  EXPECT_EQ(opened.size(), 0u);
+  EXPECT_FALSE(opened.indexOf(0));
+}
+
+TEST(KeyVault, IndexOfSearchesSortedIds) {
+  TemporaryVault vault;
+  std::vector<KeyVault::Record> records;
+  for (uint64_t id = 1000; id > 0; id -= 10) {
+    records.push_back(makeRecord(id));
+  }
+  records.push_back(makeRecord(UINT64_MAX));
+  KeyVault::write(vault.path, records);
+
+  KeyVault opened(vault.path);
+  for (size_t i = 0; i < 100; ++i) {
+    uint64_t id = 10 * (i + 1);
+    ASSERT_EQ(opened.indexOf(id), i) << id;
+    EXPECT_EQ(opened.at(i).id, id);
+    EXPECT_FALSE(opened.indexOf(id + 1)) << id + 1;
+  }
+  EXPECT_FALSE(opened.indexOf(0));
+  EXPECT_FALSE(opened.indexOf(1001));
+  EXPECT_EQ(opened.indexOf(UINT64_MAX), 100u);
+}
+
+TEST(KeyVault, WriteRejectsDuplicateAndInvalidRecords) {
+  TemporaryVault vault;
+  EXPECT_THROW(KeyVault::write(vault.path, {makeRecord(5), makeRecord(4),
+                                            makeRecord(5)}),
+               std::runtime_error);
+
+  KeyVault::Record digits = makeRecord(1);
+  digits.digits = 11;
+  KeyVault::Record noKey = makeRecord(1, 0);
+  KeyVault::Record longKey = makeRecord(1);
+  longKey.keySize = KeyVault::MAX_KEY_SIZE + 1;
+  KeyVault::Record algorithm = makeRecord(1);
+  algorithm.algorithm = 3;
+  for (const KeyVault::Record &record : {digits, noKey, longKey, algorithm}) {
+    EXPECT_THROW(KeyVault::write(vault.path, {record}), std::runtime_error);
+  }
+  // Nothing was written, not even a partial file.
+  EXPECT_FALSE(std::filesystem::exists(vault.path));
+}
+
+TEST(KeyVault, OpenRejectsForeignHeaders) {
+  TemporaryVault vault;
+  KeyVault::write(vault.path, {makeRecord(1), makeRecord(2)});
+  const std::vector<char> valid = readFile(vault.path);
+
+  patch(vault.path, offsetof(KeyVault::Header, magic), 'X');
+  EXPECT_THROW(KeyVault{vault.path}, std::runtime_error);
+
+  writeFile(vault.path, valid);
+  patch(vault.path, offsetof(KeyVault::Header, version),
+        KeyVault::VERSION + 1);
+  EXPECT_THROW(KeyVault{vault.path}, std::runtime_error);
+
+  writeFile(vault.path, valid);
+  patch(vault.path, offsetof(KeyVault::Header, recordSize), uint32_t{64});
+  EXPECT_THROW(KeyVault{vault.path}, std::runtime_error);
+
+  writeFile(vault.path, valid);
+  EXPECT_NO_THROW(KeyVault{vault.path});
+
+  writeFile(vault.path, std::vector<char>(valid.begin(), valid.begin() + 10));
+  EXPECT_THROW(KeyVault{vault.path}, std::runtime_error);
+  EXPECT_THROW(KeyVault{vault.path + ".missing"}, std::runtime_error);
+}
+
+// Every writer has its own temporary file, so the vault left behind is one
+// complete write, and no temporary file is.
+TEST(KeyVault, ConcurrentWritesDoNotCorruptEachOther) {
+  TemporaryVault vault;
+  std::vector<std::thread> writers;
+  for (uint64_t writer = 1; writer <= 4; ++writer) {
+    writers.emplace_back([&vault, writer]() {
+      for (int round = 0; round < 20; ++round) {
+        std::vector<KeyVault::Record> records;
+        for (uint64_t i = 0; i < writer * 8; ++i) {
+          records.push_back(makeRecord(writer * 1000 + i));
+        }
+        KeyVault::write(vault.path, records);
+      }
+    });
+  }
+  for (std::thread &writer : writers) {
+    writer.join();
+  }
+
+  KeyVault opened(vault.path);
+  ASSERT_GT(opened.size(), 0u);
+  uint64_t writer = opened.at(0).id / 1000;
+  EXPECT_EQ(opened.size(), writer * 8);
+  for (size_t i = 0; i < opened.size(); ++i) {
+    EXPECT_EQ(opened.at(i).id, writer * 1000 + i);
+  }
+
+  std::filesystem::path file(vault.path);
+  for (const auto &entry :
+       std::filesystem::directory_iterator(file.parent_path())) {
+    std::string name = entry.path().filename().string();
+    EXPECT_NE(name.rfind(file.filename().string() + ".", 0), 0u) << name;
+  }
+}
+
+// The size must be exactly header + count * 128 bytes.
+TEST(KeyVault, OpenRejectsSizeMismatch) {
+  TemporaryVault vault;
+  KeyVault::write(vault.path, {makeRecord(1), makeRecord(2)});
+  const std::vector<char> valid = readFile(vault.path);
+
+  for (uint64_t count : {uint64_t{0}, uint64_t{1}, uint64_t{3},
+                         UINT64_MAX / sizeof(KeyVault::Record) + 1,
+                         uint64_t{UINT64_MAX}}) {
+    writeFile(vault.path, valid);
+    patch(vault.path, offsetof(KeyVault::Header, count), count);
+    EXPECT_THROW(KeyVault{vault.path}, std::runtime_error) << count;
+  }
+
+  std::vector<char> longer = valid;
+  longer.push_back(0);
+  writeFile(vault.path, longer);
+  EXPECT_THROW(KeyVault{vault.path}, std::runtime_error);
+
+  writeFile(vault.path, std::vector<char>(valid.begin(), valid.end() - 1));
+  EXPECT_THROW(KeyVault{vault.path}, std::runtime_error);
+}
+
+// Opening checks only the header, so a damaged record is caught when read.
+TEST(KeyVault, AtRejectsCorruptRecords) {
+  TemporaryVault vault;
+  KeyVault::write(vault.path, {makeRecord(1), makeRecord(2)});
+  const std::vector<char> valid = readFile(vault.path);
+  const size_t second = recordOffset(1);
+
+  struct Corruption {
+    size_t offset;
+    uint8_t value;
+  };
+  for (Corruption corruption :
+       {Corruption{offsetof(KeyVault::Record, digits), 0},
+        Corruption{offsetof(KeyVault::Record, digits), 11},
+        Corruption{offsetof(KeyVault::Record, keySize), 0},
+        Corruption{offsetof(KeyVault::Record, keySize), 65},
+        Corruption{offsetof(KeyVault::Record, algorithm), 3},
+        Corruption{offsetof(KeyVault::Record, algorithm), 0xFF}}) {
+    writeFile(vault.path, valid);
+    patch(vault.path, second + corruption.offset, corruption.value);
+
+    KeyVault opened(vault.path);
+    EXPECT_EQ(opened.at(0).id, 1u);
+    EXPECT_EQ(opened.indexOf(2), 1u);
+    EXPECT_THROW(opened.at(1), std::runtime_error) << corruption.offset;
+    EXPECT_THROW(opened.prepareKey(1), std::runtime_error);
+  }
+}
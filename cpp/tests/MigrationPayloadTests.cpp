@@ -0,0 +1,297 @@
+#include "MigrationPayload.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using margelo::nitro::totp::MigrationAccount;
+using margelo::nitro::totp::OtpAuthUri;
+namespace Migration = margelo::nitro::totp::Migration;
+
+namespace {
+
+// An export in Google Authenticator's MigrationPayload schema, encoded with
+// protoc: three accounts covering each algorithm, both digit counts and
+// both types, and the negative batch_id real exports carry.
+const std::string EXPORT_URI =
+    "otpauth-migration://offline?data=CjAKCkhlbGxvId6tvu8SFkFDTUU6YWxpY2VA"
+    "ZXhhbXBsZS5jb20aBEFDTUUgASgBMAIKNQogMTIzNDU2Nzg5MDEyMzQ1Njc4OTAxMjM0"
+    "NTY3ODkwMTISA2JvYhoGQmlnIENvIAIoAjACCiUKFDEyMzQ1Njc4OTAxMjM0NTY3ODkw"
+    "EgVjYXJvbCADKAEwATgqEAEYASjeg%2B%2BL%2B%2F%2F%2F%2F%2F8B";
+
+std::vector<uint8_t> bytesOf(const std::string &text) {
+  return std::vector<uint8_t>(text.begin(), text.end());
+}
+
+// Accounts copied out of the callback, whose views die with it.
+struct Account {
+  OtpAuthUri::Type type;
+  std::string issuer;
+  std::string name;
+  std::vector<uint8_t> secret;
+  HMAC::Algorithm algorithm;
+  int digits;
+  uint64_t counter;
+};
+
+// Decodes from an exactly sized heap copy, so reads past the end are
+// caught by AddressSanitizer.
+bool decode(const std::vector<uint8_t> &payload,
+            std::vector<Account> &accounts) {
+  accounts.clear();
+  std::vector<uint8_t> copy(payload);
+  return Migration::decode(
+      copy.data(), copy.size(), [&accounts](const MigrationAccount &account) {
+        accounts.push_back({account.type, std::string(account.issuer),
+                            std::string(account.name),
+                            std::vector<uint8_t>(account.secret,
+                                                 account.secret +
+                                                     account.secretSize),
+                            account.algorithm, account.digits,
+                            account.counter});
+      });
+}
+
+bool accepts(const std::vector<uint8_t> &payload) {
+  std::vector<Account> accounts;
+  return decode(payload, accounts);
+}
+
+void appendVarint(uint64_t value, std::vector<uint8_t> &out) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+void appendTag(uint32_t field, uint32_t wireType, std::vector<uint8_t> &out) {
+  appendVarint(static_cast<uint64_t>(field) << 3 | wireType, out);
+}
+
+void appendBytes(uint32_t field, const std::vector<uint8_t> &bytes,
+                 std::vector<uint8_t> &out) {
+  appendTag(field, 2, out);
+  appendVarint(bytes.size(), out);
+  out.insert(out.end(), bytes.begin(), bytes.end());
+}
+
+void appendVarintField(uint32_t field, uint64_t value,
+                       std::vector<uint8_t> &out) {
+  appendTag(field, 0, out);
+  appendVarint(value, out);
+}
+
+// MigrationPayload with one OtpParameters message around `account`.
+std::vector<uint8_t> wrap(const std::vector<uint8_t> &account) {
+  std::vector<uint8_t> payload;
+  appendBytes(1, account, payload);
+  return payload;
+}
+
+std::vector<uint8_t> accountWith(uint32_t field, uint64_t value) {
+  std::vector<uint8_t> account;
+  appendBytes(1, {'k', 'e', 'y'}, account);
+  appendVarintField(field, value, account);
+  return account;
+}
+
+} // namespace
+
+TEST(MigrationPayload, DecodesGoogleAuthenticatorExport) {
+  std::vector<uint8_t> payload;
+  ASSERT_TRUE(Migration::decodeUri(EXPORT_URI, payload));
+  ASSERT_EQ(payload.size(), 159u);
+  std::vector<Account> accounts;
+  ASSERT_TRUE(decode(payload, accounts));
+  ASSERT_EQ(accounts.size(), 3u);
+
+  EXPECT_EQ(accounts[0].type, OtpAuthUri::Type::TOTP);
+  EXPECT_EQ(accounts[0].issuer, "ACME");
+  EXPECT_EQ(accounts[0].name, "ACME:alice@example.com");
+  EXPECT_EQ(accounts[0].secret,
+            std::vector<uint8_t>({'H', 'e', 'l', 'l', 'o', '!', 0xDE, 0xAD,
+                                  0xBE, 0xEF}));
+  EXPECT_EQ(accounts[0].algorithm, HMAC::Algorithm::SHA1);
+  EXPECT_EQ(accounts[0].digits, 6);
+
+  EXPECT_EQ(accounts[1].type, OtpAuthUri::Type::TOTP);
+  EXPECT_EQ(accounts[1].issuer, "Big Co");
+  EXPECT_EQ(accounts[1].name, "bob");
+  EXPECT_EQ(accounts[1].secret,
+            bytesOf("12345678901234567890123456789012"));
+  EXPECT_EQ(accounts[1].algorithm, HMAC::Algorithm::SHA256);
+  EXPECT_EQ(accounts[1].digits, 8);
+
+  EXPECT_EQ(accounts[2].type, OtpAuthUri::Type::HOTP);
+  EXPECT_EQ(accounts[2].issuer, "");
+  EXPECT_EQ(accounts[2].name, "carol");
+  EXPECT_EQ(accounts[2].secret, bytesOf("12345678901234567890"));
+  EXPECT_EQ(accounts[2].algorithm, HMAC::Algorithm::SHA512);
+  EXPECT_EQ(accounts[2].digits, 6);
+  EXPECT_EQ(accounts[2].counter, 42u);
+}
+
+TEST(MigrationPayload, DecodeUriRejectsOtherUris) {
+  std::vector<uint8_t> payload;
+  EXPECT_FALSE(Migration::decodeUri("otpauth://totp/a?data=AAAA", payload));
+  EXPECT_FALSE(Migration::decodeUri("otpauth-migration://offline?x=1",
+                                    payload));
+  EXPECT_FALSE(Migration::decodeUri(
+      "otpauth-migration://offline?data=%ZZ", payload));
+  EXPECT_FALSE(Migration::decodeUri(
+      "otpauth-migration://offline?data=!!!!", payload));
+  EXPECT_TRUE(Migration::decodeUri(
+      "otpauth-migration://offline?batch=1&data=CgA%3D", payload));
+  EXPECT_EQ(payload, std::vector<uint8_t>({0x0A, 0x00}));
+}
+
+TEST(MigrationPayload, MapsDigitsTypeAndAlgorithm) {
+  std::vector<Account> accounts;
+
+  const std::pair<uint64_t, int> digits[] = {{0, 6}, {1, 6}, {2, 8}};
+  for (auto [value, expected] : digits) {
+    ASSERT_TRUE(decode(wrap(accountWith(5, value)), accounts));
+    EXPECT_EQ(accounts.at(0).digits, expected) << value;
+  }
+
+  const std::pair<uint64_t, OtpAuthUri::Type> types[] = {
+      {0, OtpAuthUri::Type::TOTP},
+      {1, OtpAuthUri::Type::HOTP},
+      {2, OtpAuthUri::Type::TOTP}};
+  for (auto [value, expected] : types) {
+    ASSERT_TRUE(decode(wrap(accountWith(6, value)), accounts));
+    EXPECT_EQ(accounts.at(0).type, expected) << value;
+  }
+
+  const std::pair<uint64_t, HMAC::Algorithm> algorithms[] = {
+      {0, HMAC::Algorithm::SHA1},
+      {1, HMAC::Algorithm::SHA1},
+      {2, HMAC::Algorithm::SHA256},
+      {3, HMAC::Algorithm::SHA512}};
+  for (auto [value, expected] : algorithms) {
+    ASSERT_TRUE(decode(wrap(accountWith(4, value)), accounts));
+    EXPECT_EQ(accounts.at(0).algorithm, expected) << value;
+  }
+
+  ASSERT_TRUE(decode(wrap(accountWith(7, UINT64_MAX)), accounts));
+  EXPECT_EQ(accounts.at(0).counter, UINT64_MAX);
+}
+
+TEST(MigrationPayload, RejectsMd5AndUnknownAlgorithms) {
+  EXPECT_FALSE(accepts(wrap(accountWith(4, 4))));
+  EXPECT_FALSE(accepts(wrap(accountWith(4, 99))));
+}
+
+TEST(MigrationPayload, RejectsAccountsWithoutSecret) {
+  std::vector<uint8_t> account;
+  appendBytes(2, {'n'}, account);
+  EXPECT_FALSE(accepts(wrap(account)));
+
+  account.clear();
+  appendBytes(1, {}, account);
+  EXPECT_FALSE(accepts(wrap(account)));
+}
+
+// A prefix cut inside an account always fails, and no prefix may read past
+// its end.
+TEST(MigrationPayload, RejectsTruncatedPayloads) {
+  std::vector<uint8_t> payload;
+  ASSERT_TRUE(Migration::decodeUri(EXPORT_URI, payload));
+  // The OtpParameters messages end at 50, 105 and 144; the batch fields
+  // follow.
+  const size_t boundaries[] = {0, 50, 105};
+  for (size_t size = 0; size < payload.size(); ++size) {
+    std::vector<uint8_t> prefix(payload.begin(), payload.begin() + size);
+    bool insideAccount =
+        size < 144 && std::find(std::begin(boundaries), std::end(boundaries),
+                                size) == std::end(boundaries);
+    if (insideAccount) {
+      EXPECT_FALSE(accepts(prefix)) << size;
+    } else {
+      accepts(prefix);
+    }
+  }
+}
+
+TEST(MigrationPayload, RejectsLengthsPastTheEnd) {
+  // Outer length beyond the payload.
+  EXPECT_FALSE(accepts({0x0A, 0x05, 0x0A, 0x01, 'k'}));
+  // A length that would wrap the pointer.
+  std::vector<uint8_t> huge;
+  appendTag(1, 2, huge);
+  appendVarint(UINT64_MAX, huge);
+  huge.push_back(0);
+  EXPECT_FALSE(accepts(huge));
+
+  // The secret's length fits the payload but not its enclosing message.
+  std::vector<uint8_t> nested = {0x0A, 0x03, 0x0A, 0x05, 'k'};
+  nested.insert(nested.end(), {0x10, 0x01, 0x18, 0x01});
+  EXPECT_FALSE(accepts(nested));
+}
+
+TEST(MigrationPayload, RejectsBadWireTypes) {
+  for (uint32_t wireType : {3u, 4u, 6u, 7u}) {
+    std::vector<uint8_t> payload;
+    appendTag(2, wireType, payload);
+    payload.push_back(0);
+    EXPECT_FALSE(accepts(payload)) << wireType;
+
+    std::vector<uint8_t> account;
+    appendBytes(1, {'k'}, account);
+    appendTag(9, wireType, account);
+    account.push_back(0);
+    EXPECT_FALSE(accepts(wrap(account))) << wireType;
+  }
+  // Field number zero is reserved.
+  EXPECT_FALSE(accepts({0x02, 0x00}));
+}
+
+TEST(MigrationPayload, SkipsUnknownFields) {
+  std::vector<uint8_t> account;
+  appendBytes(1, {'k'}, account);
+  appendTag(20, 1, account);
+  account.insert(account.end(), 8, 0xFF);
+  appendTag(21, 5, account);
+  account.insert(account.end(), 4, 0xFF);
+  appendBytes(22, {1, 2, 3}, account);
+  appendVarintField(23, 300, account);
+
+  std::vector<uint8_t> payload = wrap(account);
+  appendVarintField(2, 1, payload);
+  appendBytes(15, {9}, payload);
+  std::vector<Account> accounts;
+  ASSERT_TRUE(decode(payload, accounts));
+  ASSERT_EQ(accounts.size(), 1u);
+  EXPECT_EQ(accounts[0].secret, std::vector<uint8_t>({'k'}));
+
+  // A fixed-size field cut short.
+  std::vector<uint8_t> truncated;
+  appendTag(3, 1, truncated);
+  truncated.insert(truncated.end(), 7, 0);
+  EXPECT_FALSE(accepts(truncated));
+}
+
+TEST(MigrationPayload, RejectsOverlongVarints) {
+  // Eleven bytes never terminate a 64-bit varint.
+  std::vector<uint8_t> tooLong = {0x10};
+  tooLong.insert(tooLong.end(), 10, 0x80);
+  tooLong.push_back(0x01);
+  EXPECT_FALSE(accepts(tooLong));
+
+  // A tenth byte above 1 would overflow 64 bits.
+  std::vector<uint8_t> overflow = {0x10};
+  overflow.insert(overflow.end(), 9, 0xFF);
+  overflow.push_back(0x02);
+  EXPECT_FALSE(accepts(overflow));
+
+  // A varint cut off by the end of the payload.
+  EXPECT_FALSE(accepts({0x10, 0x80}));
+
+  std::vector<uint8_t> maximum = {0x10};
+  maximum.insert(maximum.end(), 9, 0xFF);
+  maximum.push_back(0x01);
+  EXPECT_TRUE(accepts(maximum));
+}
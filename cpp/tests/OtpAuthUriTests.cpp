@@ -0,0 +1,187 @@
+#include "OtpAuthUri.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+
+using margelo::nitro::totp::OtpAuthArena;
+using margelo::nitro::totp::OtpAuthUri;
+namespace OtpAuth = margelo::nitro::totp::OtpAuth;
+
+namespace {
+
+bool parse(std::string_view uri, OtpAuthUri &out) {
+  // Views into a local arena dangle after return; only call this for
+  // checks that do not read decoded text.
+  OtpAuthArena arena(uri.size());
+  return OtpAuth::parse(uri, arena, out);
+}
+
+bool accepts(std::string_view uri) {
+  OtpAuthUri parsed;
+  return parse(uri, parsed);
+}
+
+} // namespace
+
+TEST(OtpAuthUri, ParsesAllFields) {
+  std::string uri = "otpauth://hotp/ACME%20Co:alice%40example.com"
+                    "?secret=JBSWY3DPEHPK3PXP&algorithm=sha256&digits=8"
+                    "&counter=42&image=https%3A%2F%2Fx";
+  OtpAuthArena arena(uri.size());
+  OtpAuthUri parsed;
+  ASSERT_TRUE(OtpAuth::parse(uri, arena, parsed));
+  EXPECT_EQ(parsed.type, OtpAuthUri::Type::HOTP);
+  EXPECT_EQ(parsed.issuer, "ACME Co");
+  EXPECT_EQ(parsed.account, "alice@example.com");
+  EXPECT_EQ(parsed.secret, "JBSWY3DPEHPK3PXP");
+  EXPECT_EQ(parsed.algorithm, HMAC::Algorithm::SHA256);
+  EXPECT_EQ(parsed.digits, 8);
+  EXPECT_EQ(parsed.counter, 42u);
+  EXPECT_EQ(parsed.period, 30u);
+}
+
+TEST(OtpAuthUri, IssuerParameterWinsOverLabelPrefix) {
+  std::string uri =
+      "otpauth://totp/Old:%20bob?issuer=New&secret=JBSWY3DPEHPK3PXP";
+  OtpAuthArena arena(uri.size());
+  OtpAuthUri parsed;
+  ASSERT_TRUE(OtpAuth::parse(uri, arena, parsed));
+  EXPECT_EQ(parsed.issuer, "New");
+  EXPECT_EQ(parsed.account, "bob");
+}
+
+TEST(OtpAuthUri, RejectsMalformedEscapes) {
+  EXPECT_FALSE(accepts("otpauth://totp/a%zzb?secret=JBSWY3DP"));
+  EXPECT_FALSE(accepts("otpauth://totp/a%G1?secret=JBSWY3DP"));
+  EXPECT_FALSE(accepts("otpauth://totp/a?secret=JBSWY3DP&issuer=x%2"));
+  EXPECT_FALSE(accepts("otpauth://totp/a?secret=JBSWY3DP&issuer=x%"));
+  EXPECT_FALSE(accepts("otpauth://totp/a%4?secret=JBSWY3DP"));
+  EXPECT_FALSE(accepts("otpauth://totp/a%"));
+  // The same escape completed is fine.
+  EXPECT_TRUE(accepts("otpauth://totp/a?secret=JBSWY3DP&issuer=x%20"));
+}
+
+TEST(OtpAuthUri, RejectsMissingSecretOrLabel) {
+  EXPECT_FALSE(accepts("otpauth://totp/alice"));
+  EXPECT_FALSE(accepts("otpauth://totp/alice?issuer=ACME"));
+  EXPECT_FALSE(accepts("otpauth://totp/alice?secret="));
+  EXPECT_FALSE(accepts("otpauth://totp/alice?secret=JBSW1Y3DP"));
+  EXPECT_FALSE(accepts("otpauth://totp/?secret=JBSWY3DP"));
+  EXPECT_FALSE(accepts("otpauth://totp/ACME:?secret=JBSWY3DP"));
+  EXPECT_FALSE(accepts("otpauth://totp?secret=JBSWY3DP"));
+  EXPECT_FALSE(accepts("otpauth://steam/alice?secret=JBSWY3DP"));
+  EXPECT_FALSE(accepts("https://totp/alice?secret=JBSWY3DP"));
+  EXPECT_TRUE(accepts("OTPAUTH://TOTP/alice?secret=jbswy3dp===="));
+}
+
+TEST(OtpAuthUri, RejectsDuplicateParameters) {
+  EXPECT_FALSE(
+      accepts("otpauth://totp/a?secret=JBSWY3DP&secret=GEZDGNBV"));
+  EXPECT_FALSE(accepts("otpauth://totp/a?secret=JBSWY3DP&digits=6&digits=8"));
+  EXPECT_FALSE(accepts("otpauth://totp/a?issuer=x&secret=JBSWY3DP&issuer=y"));
+  EXPECT_FALSE(
+      accepts("otpauth://totp/a?period=30&secret=JBSWY3DP&period=60"));
+  // Parameters without a meaning are ignored, however often they appear.
+  EXPECT_TRUE(accepts("otpauth://totp/a?image=1&secret=JBSWY3DP&image=2"));
+}
+
+TEST(OtpAuthUri, RejectsDigitsAndPeriodOutOfRange) {
+  for (const char *digits : {"0", "11", "-6", "6x", "", "99999999999"}) {
+    EXPECT_FALSE(accepts(std::string("otpauth://totp/a?secret=JBSWY3DP"
+                                      "&digits=") +
+                         digits))
+        << digits;
+  }
+  for (const char *period : {"0", "-30", "30s", "", "99999999999999999999"}) {
+    EXPECT_FALSE(accepts(std::string("otpauth://totp/a?secret=JBSWY3DP"
+                                      "&period=") +
+                         period))
+        << period;
+  }
+  EXPECT_FALSE(accepts("otpauth://hotp/a?secret=JBSWY3DP&counter=-1"));
+  EXPECT_FALSE(accepts("otpauth://totp/a?secret=JBSWY3DP&algorithm=MD5"));
+
+  OtpAuthUri parsed;
+  ASSERT_TRUE(parse("otpauth://totp/a?secret=JBSWY3DP&digits=1&period=1",
+                    parsed));
+  EXPECT_EQ(parsed.digits, 1);
+  EXPECT_EQ(parsed.period, 1u);
+  ASSERT_TRUE(parse("otpauth://totp/a?secret=JBSWY3DP&digits=10", parsed));
+  EXPECT_EQ(parsed.digits, 10);
+}
+
+// Expected strings are what encodeURIComponent produces in JavaScript.
+TEST(OtpAuthUri, BuildEncodesLikeEncodeUriComponent) {
+  OtpAuthUri uri;
+  uri.issuer = "ACME Co/Ops";
+  uri.account = "J\xC3\xBCrgen@example.com:!*'()-_.~ #&=?+";
+  uri.secret = "JBSWY3DPEHPK3PXP";
+
+  std::string built;
+  OtpAuth::build(uri, true, built);
+  EXPECT_EQ(built,
+            "otpauth://totp/ACME%20Co%2FOps:"
+            "J%C3%BCrgen%40example.com%3A!*'()-_.~%20%23%26%3D%3F%2B"
+            "?issuer=ACME%20Co%2FOps&secret=JBSWY3DPEHPK3PXP"
+            "&algorithm=SHA1&digits=6&period=30");
+}
+
+TEST(OtpAuthUri, BuildThenParseRoundTrips) {
+  for (bool issuerInLabel : {false, true}) {
+    OtpAuthUri uri;
+    uri.type = OtpAuthUri::Type::HOTP;
+    uri.issuer = "A&B: \"Q\"";
+    uri.account = "x%y z\xE2\x82\xAC";
+    uri.secret = "GEZDGNBVGY3TQOJQGEZDGNBVGY3TQOJQ";
+    uri.algorithm = HMAC::Algorithm::SHA512;
+    uri.digits = 7;
+    uri.counter = 18446744073709551615u;
+
+    std::string built;
+    OtpAuth::build(uri, issuerInLabel, built);
+    OtpAuthArena arena(built.size());
+    OtpAuthUri parsed;
+    ASSERT_TRUE(OtpAuth::parse(built, arena, parsed)) << built;
+    EXPECT_EQ(parsed.type, uri.type);
+    EXPECT_EQ(parsed.issuer, uri.issuer);
+    EXPECT_EQ(parsed.account, uri.account);
+    EXPECT_EQ(parsed.secret, uri.secret);
+    EXPECT_EQ(parsed.algorithm, uri.algorithm);
+    EXPECT_EQ(parsed.digits, uri.digits);
+    EXPECT_EQ(parsed.counter, uri.counter);
+  }
+}
+
+// An arena sized to the input always has room, even when every byte is
+// escaped, and views from earlier parses stay valid.
+TEST(OtpAuthUri, ArenaSizedToInputNeverRunsOut) {
+  std::string first = "otpauth://totp/%41%42?secret=JBSWY3DP&issuer=%43";
+  std::string second = "otpauth://totp/%44?secret=JBSWY3DP";
+  OtpAuthArena arena(first.size() + second.size());
+  OtpAuthUri a;
+  OtpAuthUri b;
+  ASSERT_TRUE(OtpAuth::parse(first, arena, a));
+  ASSERT_TRUE(OtpAuth::parse(second, arena, b));
+  EXPECT_EQ(a.account, "AB");
+  EXPECT_EQ(a.issuer, "C");
+  EXPECT_EQ(b.account, "D");
+
+  OtpAuthArena tiny(1);
+  std::string_view out;
+  EXPECT_FALSE(tiny.decode("%41%42", out));
+}
+
+TEST(OtpAuthUri, SplitsLabelAtLiteralColonFirst) {
+  std::string uri = "otpauth://totp/A%3AB:c%3Ad?secret=JBSWY3DP";
+  OtpAuthArena arena(uri.size());
+  OtpAuthUri parsed;
+  ASSERT_TRUE(OtpAuth::parse(uri, arena, parsed));
+  EXPECT_EQ(parsed.issuer, "A:B");
+  EXPECT_EQ(parsed.account, "c:d");
+
+  std::string escaped = "otpauth://totp/ACME%3a%20alice?secret=JBSWY3DP";
+  OtpAuthArena escapedArena(escaped.size());
+  ASSERT_TRUE(OtpAuth::parse(escaped, escapedArena, parsed));
+  EXPECT_EQ(parsed.issuer, "ACME");
+  EXPECT_EQ(parsed.account, "alice");
+}
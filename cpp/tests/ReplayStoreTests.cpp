@@ -0,0 +1,106 @@
+#include "ReplayStore.hpp"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+// The accept() rules over a plain map, without sweeping or probing.
+class ReferenceStore {
+public:
+  bool accept(uint64_t id, uint64_t step, uint64_t now, uint64_t expiresAt) {
+    auto it = records.find(id);
+    if (it != records.end() && now < it->second.expiresAt &&
+        step <= it->second.step) {
+      return false;
+    }
+    records[id] = Record{step, expiresAt};
+    return true;
+  }
+
+  size_t live(uint64_t now) const {
+    size_t result = 0;
+    for (const auto &[id, record] : records) {
+      result += now < record.expiresAt;
+    }
+    return result;
+  }
+
+private:
+  struct Record {
+    uint64_t step;
+    uint64_t expiresAt;
+  };
+  std::map<uint64_t, Record> records;
+};
+
+} // namespace
+
+TEST(ReplayStore, AcceptsEachStepOnce) {
+  ReplayStore store;
+  EXPECT_TRUE(store.accept(1, 100, 3000, 3100));
+  EXPECT_FALSE(store.accept(1, 100, 3000, 3100));
+  EXPECT_FALSE(store.accept(1, 99, 3010, 3090));
+  EXPECT_TRUE(store.accept(1, 101, 3030, 3130));
+  EXPECT_FALSE(store.accept(1, 101, 3040, 3130));
+  // Ids are independent.
+  EXPECT_TRUE(store.accept(2, 101, 3040, 3130));
+  EXPECT_EQ(store.size(), 2u);
+
+  // Once expired, the record no longer blocks anything.
+  EXPECT_TRUE(store.accept(1, 50, 3130, 3200));
+
+  store.clear();
+  EXPECT_EQ(store.size(), 0u);
+  EXPECT_TRUE(store.accept(2, 101, 3140, 3200));
+  EXPECT_THROW(store.accept(0, 1, 0, 1), std::runtime_error);
+}
+
+// Capacity 8 holds six records; the seventh sweeps the expired ones
+// instead of growing the table.
+TEST(ReplayStore, SweepsExpiredRecordsAtThreeQuartersLoad) {
+  ReplayStore store(8);
+  for (uint64_t id = 1; id <= 6; ++id) {
+    ASSERT_TRUE(store.accept(id, 10, 100, id % 2 == 0 ? 1000 : 200));
+  }
+  EXPECT_EQ(store.size(), 6u);
+
+  ASSERT_TRUE(store.accept(7, 10, 500, 1000));
+  EXPECT_EQ(store.size(), 4u);
+
+  // The swept slots are reused without the survivors being lost.
+  for (uint64_t id = 8; id <= 9; ++id) {
+    ASSERT_TRUE(store.accept(id, 10, 500, 1000));
+  }
+  EXPECT_EQ(store.size(), 6u);
+  for (uint64_t id = 2; id <= 9; ++id) {
+    if (id % 2 == 0 || id > 6) {
+      EXPECT_FALSE(store.accept(id, 10, 500, 1000)) << id;
+    }
+  }
+
+  // With every record live, the table grows instead.
+  ASSERT_TRUE(store.accept(10, 10, 500, 1000));
+  EXPECT_EQ(store.size(), 7u);
+}
+
+// Sweeps and growth rebuild the probe chains; every live record must still
+// be found afterwards, so a replay can never slip past a moved slot.
+TEST(ReplayStore, MatchesReferenceAcrossSweeps) {
+  std::mt19937_64 rng(20240919);
+  ReplayStore store(8);
+  ReferenceStore reference;
+  uint64_t now = 1000;
+  for (int round = 0; round < 20000; ++round) {
+    now += rng() % 3;
+    uint64_t id = 1 + rng() % 300;
+    uint64_t step = now / 30 + rng() % 3 - 1;
+    uint64_t expiresAt = now + 1 + rng() % 120;
+    ASSERT_EQ(store.accept(id, step, now, expiresAt),
+              reference.accept(id, step, now, expiresAt))
+        << "round " << round << ", id " << id;
+    ASSERT_GE(store.size(), reference.live(now));
+  }
+}
@@ -0,0 +1,112 @@
+#include "Hex.hpp"
+#include "Hmac.hpp"
+#include "Hotp.hpp"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Published test vectors. The suite runs against whichever backend
+// NITRO_TOTP_CRYPTO selected, so CI builds it once per backend.
+
+namespace {
+
+std::unique_ptr<HMAC::Key> asciiKey(HMAC::Algorithm algorithm,
+                                    const std::string &secret) {
+  return std::make_unique<HMAC::Key>(
+      algorithm, reinterpret_cast<const uint8_t *>(secret.data()),
+      secret.size());
+}
+
+std::string hex(const HMAC::Digest &digest) {
+  std::string out(Hex::encodedSize(digest.size), '\0');
+  Hex::encode(digest.bytes.data(), digest.size, out.data());
+  return out;
+}
+
+// RFC 6238 Appendix B seeds: the ASCII digits repeated to the hash size.
+const char *const TOTP_SEEDS[] = {
+    "12345678901234567890",
+    "12345678901234567890123456789012",
+    "1234567890123456789012345678901234567890123456789012345678901234",
+};
+
+} // namespace
+
+// RFC 4226 Appendix D: HMAC-SHA1 values, truncated values and 6-digit codes
+// for counters 0 .. 9.
+TEST(RfcVectors, Rfc4226Hotp) {
+  struct Vector {
+    const char *hmac;
+    uint32_t truncated;
+    uint32_t otp;
+  };
+  const Vector vectors[] = {
+      {"CC93CF18508D94934C64B65D8BA7667FB7CDE4B0", 1284755224, 755224},
+      {"75A48A19D4CBE100644E8AC1397EEA747A2D33AB", 1094287082, 287082},
+      {"0BACB7FA082FEF30782211938BC1C5E70416FF44", 137359152, 359152},
+      {"66C28227D03A2D5529262FF016A1E6EF76557ECE", 1726969429, 969429},
+      {"A904C900A64B35909874B33E61C5938A8E15ED1C", 1640338314, 338314},
+      {"A37E783D7B7233C083D4F62926C7A25F238D0316", 868254676, 254676},
+      {"BC9CD28561042C83F219324D3C607256C03272AE", 1918287922, 287922},
+      {"A4FB960C0BC06E1EABB804E5B397CDC4B45596FA", 82162583, 162583},
+      {"1B3C89F65E6C9E883012052823443F048B4332DB", 673399871, 399871},
+      {"1637409809A679DC698207310C8C7FC07290D9E5", 645520489, 520489},
+  };
+  std::unique_ptr<HMAC::Key> key =
+      asciiKey(HMAC::Algorithm::SHA1, "12345678901234567890");
+  for (uint64_t counter = 0; counter < 10; ++counter) {
+    const Vector &vector = vectors[counter];
+    HMAC::Digest digest;
+    key->computeCounter(counter, digest);
+    EXPECT_EQ(hex(digest), vector.hmac) << counter;
+    EXPECT_EQ(HOTP::compute(*key, counter, 10), vector.truncated) << counter;
+    EXPECT_EQ(HOTP::compute(*key, counter, 6), vector.otp) << counter;
+  }
+}
+
+// RFC 6238 Appendix B: 8-digit codes with a 30-second step, for every
+// algorithm, through both the single and the batched HMAC paths.
+TEST(RfcVectors, Rfc6238Totp) {
+  struct Vector {
+    uint64_t time;
+    uint32_t otp[3];
+  };
+  const Vector vectors[] = {
+      {59, {94287082, 46119246, 90693936}},
+      {1111111109, {7081804, 68084774, 25091201}},
+      {1111111111, {14050471, 67062674, 99943326}},
+      {1234567890, {89005924, 91819424, 93441116}},
+      {2000000000, {69279037, 90698825, 38618901}},
+      {20000000000, {65353130, 77737706, 47863826}},
+  };
+  const HMAC::Algorithm algorithms[] = {HMAC::Algorithm::SHA1,
+                                        HMAC::Algorithm::SHA256,
+                                        HMAC::Algorithm::SHA512};
+
+  std::vector<std::unique_ptr<HMAC::Key>> keys;
+  std::vector<const HMAC::Key *> batchKeys;
+  std::vector<uint64_t> batchCounters;
+  std::vector<uint32_t> expected;
+  for (int a = 0; a < 3; ++a) {
+    keys.push_back(asciiKey(algorithms[a], TOTP_SEEDS[a]));
+    for (const Vector &vector : vectors) {
+      uint64_t counter = vector.time / 30;
+      EXPECT_EQ(HOTP::compute(*keys.back(), counter, 8), vector.otp[a])
+          << "algorithm " << a << ", time " << vector.time;
+      batchKeys.push_back(keys.back().get());
+      batchCounters.push_back(counter);
+      expected.push_back(vector.otp[a]);
+    }
+  }
+
+  std::vector<uint32_t> otps(expected.size());
+  HOTP::computeMany(batchKeys.data(), batchCounters.data(), otps.size(), 8,
+                    otps.data());
+  EXPECT_EQ(otps, expected);
+
+  char formatted[8];
+  HOTP::format(vectors[1].otp[0], 8, formatted);
+  EXPECT_EQ(std::string(formatted, 8), "07081804");
+}
@@ -0,0 +1,64 @@
+#include "Base32.hpp"
+#include "Secret.hpp"
+#include "SecureKey.hpp"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+std::vector<uint8_t> pattern(size_t size) {
+  std::vector<uint8_t> bytes(size);
+  for (size_t i = 0; i < size; ++i) {
+    bytes[i] = static_cast<uint8_t>(i * 7 + 3);
+  }
+  return bytes;
+}
+
+std::vector<uint8_t> contents(const SecureKey &key) {
+  return std::vector<uint8_t>(key.data(), key.data() + key.size());
+}
+
+} // namespace
+
+// Keys past one slab slot must behave exactly like short ones.
+TEST(SecureKey, HoldsKeysOfAnySize) {
+  for (size_t size : {0, 1, 20, 63, 64, 65, 100, 4096, 5000}) {
+    std::vector<uint8_t> expected = pattern(size);
+    SecureKey key(expected.data(), expected.size());
+    EXPECT_EQ(contents(key), expected) << "size " << size;
+
+    SecureKey moved(std::move(key));
+    EXPECT_TRUE(key.empty());
+    EXPECT_EQ(contents(moved), expected) << "size " << size;
+  }
+}
+
+TEST(SecureKey, ResizeAcrossSlotCapacityKeepsBytes) {
+  std::vector<uint8_t> expected = pattern(40);
+  SecureKey key(expected.data(), expected.size());
+
+  key.resize(200);
+  expected.resize(200, 0);
+  EXPECT_EQ(contents(key), expected);
+
+  key.resize(10);
+  expected.resize(10);
+  EXPECT_EQ(contents(key), expected);
+
+  key.resize(SecureKey::CAPACITY);
+  expected.resize(SecureKey::CAPACITY, 0);
+  EXPECT_EQ(contents(key), expected);
+}
+
+TEST(SecureKey, SecretDecodesLongBase32AndHex) {
+  std::vector<uint8_t> expected = pattern(100);
+  Secret base32 = Secret::fromBase32(Base32::encode(expected));
+  EXPECT_EQ(contents(base32.getBytes()), expected);
+
+  Secret hex = Secret::fromHex(base32.getHex());
+  EXPECT_EQ(contents(hex.getBytes()), expected);
+  EXPECT_EQ(hex.getBase32(), base32.getBase32());
+}
@@ -0,0 +1,60 @@
+#include "Hotp.hpp"
+#include "ThreadPool.hpp"
+#include "WindowSearch.hpp"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using margelo::nitro::totp::ThreadPool;
+using margelo::nitro::totp::WindowSearch;
+
+namespace {
+
+HMAC::Key testKey() {
+  // RFC 4226 test secret "12345678901234567890".
+  const std::string secret = "12345678901234567890";
+  return HMAC::Key(HMAC::Algorithm::SHA1,
+                   reinterpret_cast<const uint8_t *>(secret.data()),
+                   secret.size());
+}
+
+} // namespace
+
+// Few digits make codes repeat across the window, so a range that finds a
+// match must still lose to a closer match in an earlier range.
+TEST(WindowSearch, MatchesSerialFind) {
+  ThreadPool pool(3);
+  const HMAC::Key key = testKey();
+  std::mt19937_64 rng(20240923);
+  for (int window : {127, 128, 200, 1000, 5000}) {
+    for (int digits : {2, 3, 4, 6}) {
+      uint64_t counter = 1000000 + rng() % 1000;
+      std::vector<uint32_t> otps = {UINT32_MAX};
+      for (int offset : {0, -window, window, window / 2, -window / 3}) {
+        otps.push_back(HOTP::compute(key, counter + offset, digits));
+      }
+      for (uint32_t otp : otps) {
+        std::optional<int> expected =
+            HOTP::find(key, counter, window, digits, otp);
+        EXPECT_EQ(WindowSearch::find(pool, key, counter, window, digits, otp),
+                  expected)
+            << "window " << window << ", digits " << digits << ", otp "
+            << otp;
+      }
+    }
+  }
+}
+
+TEST(WindowSearch, RejectsWindowsOutOfRange) {
+  ThreadPool pool(3);
+  const HMAC::Key key = testKey();
+  for (int window : {-1, HOTP::MAX_WINDOW + 1, INT32_MAX, INT32_MIN}) {
+    EXPECT_THROW(WindowSearch::find(pool, key, 100, window, 6, 0),
+                 std::runtime_error)
+        << window;
+  }
+}
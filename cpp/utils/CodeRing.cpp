@@ -0,0 +1,166 @@
+#include "CodeRing.hpp"
+#include "../core/Hotp.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace margelo::nitro::totp {
+
+// Counters at or above this cannot be tagged and are never cached.
+static constexpr uint64_t MAX_COUNTER = UINT32_MAX - 1;
+
+CodeRing::CodeRing(std::shared_ptr<const HMAC::Key> key, uint64_t period,
+                   int digits, size_t capacity)
+    : key(std::move(key)), ringPeriod(period), ringDigits(digits),
+      ringCapacity(capacity),
+      slots(std::make_unique<std::atomic<uint64_t>[]>(capacity)) {
+  if (!this->key || period == 0) {
+    throw std::runtime_error("Invalid code ring");
+  }
+  if (digits < HOTP::MIN_DIGITS || digits > HOTP::MAX_DIGITS) {
+    throw std::runtime_error("Invalid digits");
+  }
+  if (capacity == 0 || capacity > MAX_CAPACITY) {
+    throw std::runtime_error("Invalid count");
+  }
+  for (size_t i = 0; i < capacity; ++i) {
+    slots[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+void CodeRing::fill(uint64_t first) const {
+  if (first > MAX_COUNTER) {
+    return;
+  }
+  size_t count = static_cast<size_t>(
+      std::min<uint64_t>(ringCapacity, MAX_COUNTER - first + 1));
+
+  // Steps already in the ring are kept, so topping up a half-full ring
+  // only computes the codes that fell out of it.
+  std::vector<uint64_t> counters;
+  counters.reserve(count);
+  for (uint64_t counter = first; counter < first + count; ++counter) {
+    uint64_t packed =
+        slots[counter % ringCapacity].load(std::memory_order_relaxed);
+    if ((packed >> 32) != counter + 1) {
+      counters.push_back(counter);
+    }
+  }
+
+  std::vector<const HMAC::Key *> keys(counters.size(), key.get());
+  std::vector<uint32_t> otps(counters.size());
+  HOTP::computeMany(keys.data(), counters.data(), counters.size(), ringDigits,
+                    otps.data());
+
+  // Concurrent fills may interleave; every slot is self-describing, so the
+  // worst case is recomputing a code that was already there.
+  for (size_t i = 0; i < counters.size(); ++i) {
+    uint64_t packed = ((counters[i] + 1) << 32) | otps[i];
+    slots[counters[i] % ringCapacity].store(packed, std::memory_order_release);
+  }
+
+  uint64_t end = first + count;
+  uint64_t current = filledUntil.load(std::memory_order_relaxed);
+  while (current < end &&
+         !filledUntil.compare_exchange_weak(current, end,
+                                            std::memory_order_relaxed)) {
+  }
+}
+
+std::optional<uint32_t> CodeRing::get(uint64_t counter) const {
+  if (counter > MAX_COUNTER) {
+    return std::nullopt;
+  }
+
+  uint64_t packed =
+      slots[counter % ringCapacity].load(std::memory_order_acquire);
+  bool hit = (packed >> 32) == counter + 1;
+
+  // Only lookups around the filled range move it forward. A step far
+  // behind or ahead of it (a skewed clock, a probe of another time) would
+  // otherwise refill the ring around itself and evict the upcoming codes.
+  uint64_t end = filledUntil.load(std::memory_order_relaxed);
+  uint64_t half = ringCapacity / 2;
+  bool current = counter + ringCapacity >= end && counter <= end + half;
+  if (current && (!hit || end < counter + 1 + half)) {
+    refillAsync(counter);
+  }
+
+  if (!hit) {
+    return std::nullopt;
+  }
+  return static_cast<uint32_t>(packed);
+}
+
+void CodeRing::refillAsync(uint64_t first) const {
+  if (refilling.exchange(true, std::memory_order_acquire)) {
+    return;
+  }
+  ThreadPool::shared().submit([self = shared_from_this(), first]() {
+    try {
+      self->fill(first);
+    } catch (...) {
+      // Readers fall back to computing codes themselves.
+    }
+    self->refilling.store(false, std::memory_order_release);
+  });
+}
+
+std::optional<uint32_t> SharedCodeRing::get(uint64_t period, int digits,
+                                            uint64_t counter) const {
+  // Sequentially consistent, pairing with waitForReaders(): either this
+  // load sees the new ring, or the writer sees this reader and waits.
+  uint32_t index = epoch.load() & 1;
+  readers[index].fetch_add(1);
+  const CodeRing *current = ring.load();
+  std::optional<uint32_t> otp;
+  if (current && current->period() == period && current->digits() == digits) {
+    otp = current->get(counter);
+  }
+  readers[index].fetch_sub(1, std::memory_order_release);
+  return otp;
+}
+
+std::shared_ptr<const CodeRing>
+SharedCodeRing::use(const std::shared_ptr<const HMAC::Key> &key,
+                    uint64_t period, int digits, size_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (current && current->period() == period && current->digits() == digits &&
+      current->capacity() == capacity) {
+    return current;
+  }
+
+  auto next = std::make_shared<CodeRing>(key, period, digits, capacity);
+  std::shared_ptr<const CodeRing> previous = std::exchange(current, next);
+  ring.store(next.get());
+  if (previous) {
+    waitForReaders();
+  }
+  return next;
+}
+
+void SharedCodeRing::waitForReaders() {
+  // A reader may pick its counter before a flip and announce itself after
+  // it, so each counter is drained once after flipping away from it. New
+  // readers only join the other counter, so every wait is bounded by the
+  // readers already running, each of which holds the ring for one load.
+  for (int pass = 0; pass < 2; ++pass) {
+    uint32_t index = epoch.fetch_add(1) & 1;
+    while (readers[index].load() != 0) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+size_t SharedCodeRing::memorySize() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (!current) {
+    return 0;
+  }
+  return sizeof(CodeRing) + current->capacity() * sizeof(uint64_t);
+}
+
+} // namespace margelo::nitro::totp
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "../core/Hmac.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace margelo::nitro::totp {
+
+// Fixed-size ring of upcoming codes for one key, period and digit count.
+// fill() computes a run of consecutive time steps in one batched HMAC pass;
+// get() is a single atomic load, and tops the ring up on the thread pool
+// once fewer than half of its codes lie ahead of the requested step. Steps
+// outside [filled end - capacity, filled end + capacity / 2] are treated as
+// strays and never trigger a refill; after a longer gap, fill() again.
+class CodeRing : public std::enable_shared_from_this<CodeRing> {
+public:
+  static constexpr size_t MAX_CAPACITY = 1024;
+
+  CodeRing(std::shared_ptr<const HMAC::Key> key, uint64_t period, int digits,
+           size_t capacity);
+
+  CodeRing(const CodeRing &) = delete;
+  CodeRing &operator=(const CodeRing &) = delete;
+
+  uint64_t period() const { return ringPeriod; }
+  int digits() const { return ringDigits; }
+  size_t capacity() const { return ringCapacity; }
+
+  // Computes the codes of counters first .. first + capacity() - 1.
+  void fill(uint64_t first) const;
+
+  // Lock-free. Returns the code of `counter`, or nothing when it has not
+  // been computed yet; either way a background refill may be scheduled if
+  // `counter` is near the filled range.
+  std::optional<uint32_t> get(uint64_t counter) const;
+
+private:
+  void refillAsync(uint64_t first) const;
+
+  std::shared_ptr<const HMAC::Key> key;
+  uint64_t ringPeriod;
+  int ringDigits;
+  size_t ringCapacity;
+  // Each slot packs (counter + 1) << 32 | code, so a reader can tell from the
+  // slot alone whether it holds the step it asked for; 0 means empty.
+  std::unique_ptr<std::atomic<uint64_t>[]> slots;
+  // One past the highest counter filled so far.
+  mutable std::atomic<uint64_t> filledUntil{0};
+  mutable std::atomic<bool> refilling{false};
+};
+
+// The current CodeRing of one key. get() stays lock-free while use() swaps
+// in a ring for other parameters; the replaced ring is released once no
+// get() can still be reading it, so a key holds one ring at a time.
+class SharedCodeRing {
+public:
+  SharedCodeRing() = default;
+
+  SharedCodeRing(const SharedCodeRing &) = delete;
+  SharedCodeRing &operator=(const SharedCodeRing &) = delete;
+
+  // Lock-free. The code of `counter`, if the current ring was built for
+  // `period` and `digits` and holds that step.
+  std::optional<uint32_t> get(uint64_t period, int digits,
+                              uint64_t counter) const;
+
+  // Returns the current ring, first replacing it with a new one for `key`,
+  // `period` and `digits` holding `capacity` codes unless it matches.
+  std::shared_ptr<const CodeRing>
+  use(const std::shared_ptr<const HMAC::Key> &key, uint64_t period,
+      int digits, size_t capacity);
+
+  // Bytes held by the current ring, if any.
+  size_t memorySize() const;
+
+private:
+  void waitForReaders();
+
+  std::atomic<const CodeRing *> ring{nullptr};
+  // Readers announce themselves in the counter `epoch` selects. A writer
+  // flips the epoch before draining a counter, so it only waits for
+  // readers that were already running, never for a stream of new ones.
+  mutable std::atomic<uint32_t> epoch{0};
+  mutable std::atomic<uint32_t> readers[2] = {};
+  mutable std::mutex mutex;
+  // Owns `ring`; only touched under `mutex`.
+  std::shared_ptr<const CodeRing> current;
+};
+
+} // namespace margelo::nitro::totp
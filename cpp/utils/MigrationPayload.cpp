@@ -0,0 +1,237 @@
+#include "MigrationPayload.hpp"
+#include "../core/Base64.hpp"
+
+namespace margelo::nitro::totp {
+
+namespace Migration {
+
+namespace {
+
+// Protobuf wire types used by the payload.
+constexpr uint32_t VARINT = 0;
+constexpr uint32_t FIXED64 = 1;
+constexpr uint32_t LENGTH_DELIMITED = 2;
+constexpr uint32_t FIXED32 = 5;
+
+// Field numbers of MigrationPayload and MigrationPayload.OtpParameters.
+constexpr uint32_t PAYLOAD_OTP_PARAMETERS = 1;
+constexpr uint32_t OTP_SECRET = 1;
+constexpr uint32_t OTP_NAME = 2;
+constexpr uint32_t OTP_ISSUER = 3;
+constexpr uint32_t OTP_ALGORITHM = 4;
+constexpr uint32_t OTP_DIGITS = 5;
+constexpr uint32_t OTP_TYPE = 6;
+constexpr uint32_t OTP_COUNTER = 7;
+
+class Reader {
+public:
+  Reader(const uint8_t *data, size_t size) : cursor(data), end(data + size) {}
+
+  bool done() const { return cursor == end; }
+
+  bool varint(uint64_t &out) {
+    out = 0;
+    for (int shift = 0; shift < 64 && cursor != end; shift += 7) {
+      uint8_t byte = *cursor++;
+      // The tenth byte holds only the top bit of a 64-bit value.
+      if (shift == 63 && byte > 1) {
+        return false;
+      }
+      out |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool tag(uint32_t &field, uint32_t &wireType) {
+    uint64_t value;
+    if (!varint(value) || (value >> 3) == 0 || (value >> 3) > UINT32_MAX) {
+      return false;
+    }
+    field = static_cast<uint32_t>(value >> 3);
+    wireType = static_cast<uint32_t>(value & 7);
+    return true;
+  }
+
+  bool bytes(const uint8_t *&data, size_t &size) {
+    uint64_t length;
+    if (!varint(length) || length > static_cast<uint64_t>(end - cursor)) {
+      return false;
+    }
+    data = cursor;
+    size = static_cast<size_t>(length);
+    cursor += size;
+    return true;
+  }
+
+  bool skip(uint32_t wireType) {
+    uint64_t value;
+    const uint8_t *data;
+    size_t size;
+    switch (wireType) {
+    case VARINT:
+      return varint(value);
+    case FIXED64:
+      return advance(8);
+    case LENGTH_DELIMITED:
+      return bytes(data, size);
+    case FIXED32:
+      return advance(4);
+    default:
+      return false;
+    }
+  }
+
+private:
+  bool advance(size_t size) {
+    if (size > static_cast<size_t>(end - cursor)) {
+      return false;
+    }
+    cursor += size;
+    return true;
+  }
+
+  const uint8_t *cursor;
+  const uint8_t *end;
+};
+
+std::string_view toView(const uint8_t *data, size_t size) {
+  return std::string_view(reinterpret_cast<const char *>(data), size);
+}
+
+bool toAlgorithm(uint64_t value, HMAC::Algorithm &out) {
+  switch (value) {
+  case 0: // ALGORITHM_UNSPECIFIED
+  case 1:
+    out = HMAC::Algorithm::SHA1;
+    return true;
+  case 2:
+    out = HMAC::Algorithm::SHA256;
+    return true;
+  case 3:
+    out = HMAC::Algorithm::SHA512;
+    return true;
+  default: // MD5 and anything newer
+    return false;
+  }
+}
+
+bool decodeAccount(const uint8_t *data, size_t size, MigrationAccount &out) {
+  out = MigrationAccount();
+  Reader reader(data, size);
+  while (!reader.done()) {
+    uint32_t field, wireType;
+    if (!reader.tag(field, wireType)) {
+      return false;
+    }
+
+    const uint8_t *bytes;
+    size_t length;
+    uint64_t value;
+    if (wireType == LENGTH_DELIMITED &&
+        (field == OTP_SECRET || field == OTP_NAME || field == OTP_ISSUER)) {
+      if (!reader.bytes(bytes, length)) {
+        return false;
+      }
+      if (field == OTP_SECRET) {
+        out.secret = bytes;
+        out.secretSize = length;
+      } else if (field == OTP_NAME) {
+        out.name = toView(bytes, length);
+      } else {
+        out.issuer = toView(bytes, length);
+      }
+    } else if (wireType == VARINT &&
+               (field == OTP_ALGORITHM || field == OTP_DIGITS ||
+                field == OTP_TYPE || field == OTP_COUNTER)) {
+      if (!reader.varint(value)) {
+        return false;
+      }
+      if (field == OTP_ALGORITHM) {
+        if (!toAlgorithm(value, out.algorithm)) {
+          return false;
+        }
+      } else if (field == OTP_DIGITS) {
+        // DIGIT_COUNT_UNSPECIFIED, SIX, EIGHT.
+        out.digits = value == 2 ? 8 : 6;
+      } else if (field == OTP_TYPE) {
+        // OTP_TYPE_UNSPECIFIED, HOTP, TOTP.
+        out.type = value == 1 ? OtpAuthUri::Type::HOTP : OtpAuthUri::Type::TOTP;
+      } else {
+        out.counter = value;
+      }
+    } else if (!reader.skip(wireType)) {
+      return false;
+    }
+  }
+  return out.secretSize > 0;
+}
+
+} // namespace
+
+bool decodeUri(std::string_view uri, std::vector<uint8_t> &payload) {
+  constexpr std::string_view prefix = "otpauth-migration://offline?";
+  if (uri.substr(0, prefix.size()) != prefix) {
+    return false;
+  }
+  std::string_view query = uri.substr(prefix.size());
+
+  while (!query.empty()) {
+    size_t ampersand = query.find('&');
+    std::string_view pair = query.substr(0, ampersand);
+    query = ampersand == std::string_view::npos ? ""
+                                                : query.substr(ampersand + 1);
+    if (pair.substr(0, 5) != "data=") {
+      continue;
+    }
+
+    // Base64 in a URI is usually percent-encoded ('+', '/', '=').
+    OtpAuthArena arena(pair.size());
+    std::string_view data;
+    if (!arena.decode(pair.substr(5), data)) {
+      return false;
+    }
+    payload.resize(Base64::maxDecodedSize(data.size()));
+    size_t size;
+    if (!Base64::decode(data, payload.data(), size)) {
+      return false;
+    }
+    payload.resize(size);
+    return true;
+  }
+  return false;
+}
+
+bool decode(const uint8_t *data, size_t size,
+            const AccountCallback &onAccount) {
+  Reader reader(data, size);
+  MigrationAccount account;
+  while (!reader.done()) {
+    uint32_t field, wireType;
+    if (!reader.tag(field, wireType)) {
+      return false;
+    }
+    if (field != PAYLOAD_OTP_PARAMETERS || wireType != LENGTH_DELIMITED) {
+      // version, batch_size, batch_index, batch_id
+      if (!reader.skip(wireType)) {
+        return false;
+      }
+      continue;
+    }
+
+    const uint8_t *message;
+    size_t length;
+    if (!reader.bytes(message, length) ||
+        !decodeAccount(message, length, account)) {
+      return false;
+    }
+    onAccount(account);
+  }
+  return true;
+}
+
+} // namespace Migration
+
+} // namespace margelo::nitro::totp
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "../core/Hmac.hpp"
+#include "OtpAuthUri.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+namespace margelo::nitro::totp {
+
+// One account of a Google Authenticator export. The views and the secret
+// point into the decoded payload and are only valid during the callback.
+struct MigrationAccount {
+  OtpAuthUri::Type type = OtpAuthUri::Type::TOTP;
+  std::string_view issuer;
+  std::string_view name;
+  const uint8_t *secret = nullptr;
+  size_t secretSize = 0;
+  HMAC::Algorithm algorithm = HMAC::Algorithm::SHA1;
+  int digits = 6;
+  uint64_t counter = 0;
+};
+
+namespace Migration {
+
+using AccountCallback = std::function<void(const MigrationAccount &)>;
+
+// Extracts the `data` parameter of an otpauth-migration://offline URI and
+// decodes its Base64 into `payload`. Returns false for any other URI. The
+// payload holds raw secrets; wipe it with SecureMemory::wipe when done.
+bool decodeUri(std::string_view uri, std::vector<uint8_t> &payload);
+
+// Walks the MigrationPayload protobuf in a single pass without building
+// intermediate messages, calling `onAccount` for every account in order.
+// Unknown fields are skipped. Returns false for malformed input and for
+// accounts using an algorithm other than SHA-1/256/512; accounts before the
+// failure have already been delivered.
+bool decode(const uint8_t *data, size_t size, const AccountCallback &onAccount);
+
+} // namespace Migration
+
+} // namespace margelo::nitro::totp
@@ -0,0 +1,335 @@
+#include "OtpAuthUri.hpp"
+#include "../core/Hotp.hpp"
+#include "../core/SecureMemory.hpp"
+#include <charconv>
+#include <cstring>
+#include <iterator>
+
+namespace margelo::nitro::totp {
+
+OtpAuthArena::OtpAuthArena(size_t capacity)
+    : data(std::make_unique<char[]>(capacity)), capacity(capacity) {}
+
+OtpAuthArena::~OtpAuthArena() { SecureMemory::wipe(data.get(), used); }
+
+static int hexValue(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  return -1;
+}
+
+bool OtpAuthArena::decode(std::string_view text, std::string_view &out) {
+  size_t escape = text.find('%');
+  if (escape == std::string_view::npos) {
+    out = text;
+    return true;
+  }
+  if (capacity - used < text.size()) {
+    return false;
+  }
+
+  char *start = data.get() + used;
+  std::memcpy(start, text.data(), escape);
+  char *write = start + escape;
+  for (size_t i = escape; i < text.size(); ++i) {
+    if (text[i] != '%') {
+      *write++ = text[i];
+      continue;
+    }
+    if (i + 2 >= text.size()) {
+      return false;
+    }
+    int high = hexValue(text[i + 1]);
+    int low = hexValue(text[i + 2]);
+    if (high < 0 || low < 0) {
+      return false;
+    }
+    *write++ = static_cast<char>(high << 4 | low);
+    i += 2;
+  }
+
+  size_t size = static_cast<size_t>(write - start);
+  used += size;
+  out = std::string_view(start, size);
+  return true;
+}
+
+namespace OtpAuth {
+
+static bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); ++i) {
+    char c = a[i];
+    if (c >= 'A' && c <= 'Z') {
+      c = static_cast<char>(c - 'A' + 'a');
+    }
+    if (c != b[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool startsWithIgnoreCase(std::string_view text,
+                                 std::string_view prefix) {
+  return text.size() >= prefix.size() &&
+         equalsIgnoreCase(text.substr(0, prefix.size()), prefix);
+}
+
+template <typename T>
+static bool parseNumber(std::string_view text, T &out) {
+  const char *end = text.data() + text.size();
+  auto [pointer, error] = std::from_chars(text.data(), end, out);
+  return error == std::errc() && pointer == end;
+}
+
+// Base32 alphabet in either case, optionally followed by '=' padding.
+static bool isBase32(std::string_view text) {
+  size_t size = text.size();
+  while (size > 0 && text[size - 1] == '=') {
+    --size;
+  }
+  if (size == 0) {
+    return false;
+  }
+  for (size_t i = 0; i < size; ++i) {
+    char c = text[i];
+    bool valid = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
+                 (c >= '2' && c <= '7');
+    if (!valid) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool parseAlgorithm(std::string_view text, HMAC::Algorithm &out) {
+  if (equalsIgnoreCase(text, "sha1")) {
+    out = HMAC::Algorithm::SHA1;
+  } else if (equalsIgnoreCase(text, "sha256")) {
+    out = HMAC::Algorithm::SHA256;
+  } else if (equalsIgnoreCase(text, "sha512")) {
+    out = HMAC::Algorithm::SHA512;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+static size_t findEscapedColon(std::string_view text) {
+  for (size_t i = 0; i + 2 < text.size(); ++i) {
+    if (text[i] == '%' && text[i + 1] == '3' &&
+        (text[i + 2] == 'A' || text[i + 2] == 'a')) {
+      return i;
+    }
+  }
+  return std::string_view::npos;
+}
+
+// Parameters with a meaning; each index is a bit of the `seen` mask in
+// parse().
+static constexpr std::string_view PARAMETERS[] = {
+    "secret", "issuer", "algorithm", "digits", "period", "counter"};
+
+static bool parseParameter(std::string_view name, std::string_view value,
+                           OtpAuthUri &out) {
+  if (name == "secret") {
+    out.secret = value;
+    return isBase32(value);
+  }
+  if (name == "issuer") {
+    out.issuer = value;
+    return true;
+  }
+  if (name == "algorithm") {
+    return parseAlgorithm(value, out.algorithm);
+  }
+  if (name == "digits") {
+    return parseNumber(value, out.digits) && out.digits >= HOTP::MIN_DIGITS &&
+           out.digits <= HOTP::MAX_DIGITS;
+  }
+  if (name == "period") {
+    return parseNumber(value, out.period) && out.period > 0;
+  }
+  if (name == "counter") {
+    return parseNumber(value, out.counter);
+  }
+  // Unknown parameters (image, color, ...) are ignored.
+  return true;
+}
+
+// A known parameter given twice is ambiguous (which secret is meant?), so
+// it fails the parse. Unknown parameters may repeat.
+static bool markParameter(std::string_view name, unsigned &seen) {
+  for (size_t i = 0; i < std::size(PARAMETERS); ++i) {
+    if (name == PARAMETERS[i]) {
+      unsigned bit = 1u << i;
+      if (seen & bit) {
+        return false;
+      }
+      seen |= bit;
+      return true;
+    }
+  }
+  return true;
+}
+
+bool parse(std::string_view uri, OtpAuthArena &arena, OtpAuthUri &out) {
+  out = OtpAuthUri();
+
+  constexpr std::string_view scheme = "otpauth://";
+  if (!startsWithIgnoreCase(uri, scheme)) {
+    return false;
+  }
+  uri.remove_prefix(scheme.size());
+
+  size_t slash = uri.find('/');
+  if (slash == std::string_view::npos) {
+    return false;
+  }
+  std::string_view type = uri.substr(0, slash);
+  if (equalsIgnoreCase(type, "totp")) {
+    out.type = OtpAuthUri::Type::TOTP;
+  } else if (equalsIgnoreCase(type, "hotp")) {
+    out.type = OtpAuthUri::Type::HOTP;
+  } else {
+    return false;
+  }
+  uri.remove_prefix(slash + 1);
+
+  size_t question = uri.find('?');
+  std::string_view rawLabel = uri.substr(0, question);
+
+  // "Issuer:account", where spaces may follow the colon. The label is split
+  // before decoding, so an escaped colon inside the issuer stays part of
+  // it; only labels without a literal colon are split at an escaped one.
+  size_t colon = rawLabel.find(':');
+  size_t separatorSize = 1;
+  if (colon == std::string_view::npos) {
+    colon = findEscapedColon(rawLabel);
+    separatorSize = 3;
+  }
+  std::string_view labelIssuer;
+  if (colon != std::string_view::npos) {
+    if (!arena.decode(rawLabel.substr(0, colon), labelIssuer)) {
+      return false;
+    }
+    rawLabel.remove_prefix(colon + separatorSize);
+  }
+  std::string_view label;
+  if (!arena.decode(rawLabel, label)) {
+    return false;
+  }
+  while (!label.empty() && label.front() == ' ') {
+    label.remove_prefix(1);
+  }
+  if (label.empty()) {
+    return false;
+  }
+  out.account = label;
+
+  unsigned seen = 0;
+  std::string_view query =
+      question == std::string_view::npos ? "" : uri.substr(question + 1);
+  while (!query.empty()) {
+    size_t ampersand = query.find('&');
+    std::string_view pair = query.substr(0, ampersand);
+    query = ampersand == std::string_view::npos ? ""
+                                                : query.substr(ampersand + 1);
+    if (pair.empty()) {
+      continue;
+    }
+
+    size_t equals = pair.find('=');
+    std::string_view name = pair.substr(0, equals);
+    std::string_view value;
+    if (!markParameter(name, seen) ||
+        !arena.decode(equals == std::string_view::npos
+                          ? std::string_view()
+                          : pair.substr(equals + 1),
+                      value) ||
+        !parseParameter(name, value, out)) {
+      return false;
+    }
+  }
+
+  if (out.issuer.empty()) {
+    out.issuer = labelIssuer;
+  }
+  // PARAMETERS[0] is the secret, which is required.
+  return (seen & 1u) != 0;
+}
+
+// Characters encodeURIComponent leaves as they are.
+static bool isUnreserved(unsigned char c) {
+  return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
+         (c >= '0' && c <= '9') || std::strchr("-_.!~*'()", c) != nullptr;
+}
+
+static void appendEncoded(std::string_view text, std::string &out) {
+  static constexpr char hex[] = "0123456789ABCDEF";
+  for (char ch : text) {
+    unsigned char c = static_cast<unsigned char>(ch);
+    if (c != 0 && isUnreserved(c)) {
+      out.push_back(ch);
+    } else {
+      out.push_back('%');
+      out.push_back(hex[c >> 4]);
+      out.push_back(hex[c & 15]);
+    }
+  }
+}
+
+static std::string_view algorithmName(HMAC::Algorithm algorithm) {
+  switch (algorithm) {
+  case HMAC::Algorithm::SHA1:
+    return "SHA1";
+  case HMAC::Algorithm::SHA256:
+    return "SHA256";
+  case HMAC::Algorithm::SHA512:
+    return "SHA512";
+  }
+  return "SHA1";
+}
+
+void build(const OtpAuthUri &uri, bool issuerInLabel, std::string &out) {
+  out.append(uri.type == OtpAuthUri::Type::HOTP ? "otpauth://hotp/"
+                                                : "otpauth://totp/");
+  if (!uri.issuer.empty() && issuerInLabel) {
+    appendEncoded(uri.issuer, out);
+    out.push_back(':');
+  }
+  appendEncoded(uri.account, out);
+  out.push_back('?');
+  if (!uri.issuer.empty()) {
+    out.append("issuer=");
+    appendEncoded(uri.issuer, out);
+    out.push_back('&');
+  }
+  out.append("secret=");
+  appendEncoded(uri.secret, out);
+  out.append("&algorithm=");
+  out.append(algorithmName(uri.algorithm));
+  out.append("&digits=");
+  out.append(std::to_string(uri.digits));
+  if (uri.type == OtpAuthUri::Type::HOTP) {
+    out.append("&counter=");
+    out.append(std::to_string(uri.counter));
+  } else {
+    out.append("&period=");
+    out.append(std::to_string(uri.period));
+  }
+}
+
+} // namespace OtpAuth
+
+} // namespace margelo::nitro::totp
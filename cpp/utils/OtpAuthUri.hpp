@@ -0,0 +1,67 @@
+#pragma once
+
+#include "../core/Hmac.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace margelo::nitro::totp {
+
+// Fields of an otpauth:// URI. The views point either into the URI itself
+// or, for percent-encoded text, into the OtpAuthArena it was parsed with.
+// `secret` can be handed straight to Secret::fromBase32.
+struct OtpAuthUri {
+  enum class Type : uint8_t { TOTP, HOTP };
+
+  Type type = Type::TOTP;
+  std::string_view issuer;
+  std::string_view account;
+  std::string_view secret;
+  HMAC::Algorithm algorithm = HMAC::Algorithm::SHA1;
+  int digits = 6;
+  uint64_t period = 30;
+  uint64_t counter = 0;
+};
+
+// Bump allocator for percent-decoded text. Decoding never makes text longer,
+// so an arena sized to the combined length of the URIs parsed with it never
+// runs out and never moves, keeping every view it handed out valid.
+class OtpAuthArena {
+public:
+  explicit OtpAuthArena(size_t capacity);
+  // Wipes the decoded text, which may include secrets.
+  ~OtpAuthArena();
+
+  OtpAuthArena(const OtpAuthArena &) = delete;
+  OtpAuthArena &operator=(const OtpAuthArena &) = delete;
+
+  // Returns `text` itself when it holds no escapes, otherwise its decoded
+  // copy in the arena. Returns false for malformed escapes or when the arena
+  // is full.
+  bool decode(std::string_view text, std::string_view &out);
+
+private:
+  std::unique_ptr<char[]> data;
+  size_t capacity;
+  size_t used = 0;
+};
+
+namespace OtpAuth {
+
+// Parses otpauth://TYPE/LABEL?PARAMETERS as written by Google Authenticator
+// and most issuers. Missing parameters keep the defaults of OtpAuthUri; an
+// `issuer` parameter wins over a label prefix. Returns false for anything
+// else, including a missing or non-Base32 secret, an empty account name and
+// a known parameter given twice.
+bool parse(std::string_view uri, OtpAuthArena &arena, OtpAuthUri &out);
+
+// Appends the URI for `uri` to `out`, percent-encoding the label and the
+// parameters exactly like JavaScript's encodeURIComponent. The issuer goes
+// into the `issuer` parameter and, with `issuerInLabel`, the label prefix.
+void build(const OtpAuthUri &uri, bool issuerInLabel, std::string &out);
+
+} // namespace OtpAuth
+
+} // namespace margelo::nitro::totp
@@ -0,0 +1,130 @@
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace margelo::nitro::totp {
+
+ThreadPool::ThreadPool(size_t threads) {
+  workers.reserve(threads);
+  for (size_t i = 0; i < threads; ++i) {
+    workers.emplace_back([this] { run(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  condition.notify_all();
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+}
+
+ThreadPool &ThreadPool::shared() {
+  // Intentionally leaked so detached work never races static destruction.
+  static ThreadPool *pool =
+      new ThreadPool(std::max(1u, std::thread::hardware_concurrency()));
+  return *pool;
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    tasks.push_back(std::move(task));
+  }
+  condition.notify_one();
+}
+
+void ThreadPool::run() {
+  for (;;) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      condition.wait(lock, [this] { return stopping || !tasks.empty(); });
+      if (stopping && tasks.empty()) {
+        return;
+      }
+      task = std::move(tasks.front());
+      tasks.pop_front();
+    }
+    task();
+  }
+}
+
+namespace {
+
+// Shared between the caller and its helpers; helpers that start after all
+// indices were claimed only touch this state, which they keep alive.
+struct ParallelForState {
+  std::function<void(size_t)> body;
+  size_t count = 0;
+  std::atomic<size_t> next{0};
+
+  std::mutex mutex;
+  std::condition_variable done;
+  size_t active = 0;
+  std::exception_ptr error;
+
+  void work() {
+    for (;;) {
+      size_t index = next.fetch_add(1);
+      if (index >= count) {
+        return;
+      }
+      try {
+        body(index);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+    }
+  }
+};
+
+} // namespace
+
+void ThreadPool::parallelFor(size_t count,
+                             const std::function<void(size_t)> &body) {
+  if (count == 0) {
+    return;
+  }
+
+  auto state = std::make_shared<ParallelForState>();
+  state->body = body;
+  state->count = count;
+
+  size_t helpers = std::min(count - 1, workers.size());
+  for (size_t i = 0; i < helpers; ++i) {
+    submit([state] {
+      {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->next.load() >= state->count) {
+          return;
+        }
+        ++state->active;
+      }
+      state->work();
+      {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        --state->active;
+      }
+      state->done.notify_all();
+    });
+  }
+
+  state->work();
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->done.wait(lock, [&state] { return state->active == 0; });
+  if (state->error) {
+    std::rethrow_exception(state->error);
+  }
+}
+
+} // namespace margelo::nitro::totp
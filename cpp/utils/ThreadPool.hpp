@@ -0,0 +1,46 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace margelo::nitro::totp {
+
+// Small fixed-size worker pool for CPU-bound OTP work that should not run
+// serially on the JS thread.
+class ThreadPool {
+public:
+  explicit ThreadPool(size_t threads);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  // Process-wide pool sized to the number of hardware threads.
+  static ThreadPool &shared();
+
+  size_t size() const { return workers.size(); }
+
+  void submit(std::function<void()> task);
+
+  // Runs body(0) .. body(count - 1) on the pool and the calling thread and
+  // returns once all of them finished. The caller claims work itself and
+  // never waits on a task that has not started, so this is safe to call from
+  // a pool worker. The first exception thrown by `body` is rethrown here.
+  void parallelFor(size_t count, const std::function<void(size_t)> &body);
+
+private:
+  void run();
+
+  std::vector<std::thread> workers;
+  std::deque<std::function<void()>> tasks;
+  std::mutex mutex;
+  std::condition_variable condition;
+  bool stopping = false;
+};
+
+} // namespace margelo::nitro::totp
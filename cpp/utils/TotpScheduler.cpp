@@ -0,0 +1,172 @@
+#include "TotpScheduler.hpp"
+#include "../core/Hotp.hpp"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+namespace margelo::nitro::totp {
+
+using Clock = std::chrono::system_clock;
+
+static uint64_t nowMilliseconds() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          Clock::now().time_since_epoch())
+          .count());
+}
+
+TotpScheduler::~TotpScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  condition.notify_all();
+  if (timer.joinable()) {
+    timer.join();
+  }
+}
+
+TotpScheduler &TotpScheduler::shared() {
+  // Intentionally leaked, like ThreadPool::shared().
+  static TotpScheduler *scheduler = new TotpScheduler();
+  return *scheduler;
+}
+
+uint64_t TotpScheduler::subscribe(std::vector<Entry> entries, int digits,
+                                  Listener listener) {
+  if (digits < HOTP::MIN_DIGITS || digits > HOTP::MAX_DIGITS) {
+    throw std::runtime_error("Invalid digits");
+  }
+  if (entries.empty()) {
+    throw std::runtime_error("Subscription needs at least one key");
+  }
+  for (const Entry &entry : entries) {
+    if (!entry.key || entry.period == 0 || entry.period > MAX_PERIOD) {
+      throw std::runtime_error("Invalid subscription entry");
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  uint64_t id = nextId++;
+  Subscription &subscription = subscriptions[id];
+  subscription.counters.assign(entries.size(), UINT64_MAX);
+  subscription.entries = std::move(entries);
+  subscription.digits = digits;
+  subscription.listener =
+      std::make_shared<const Listener>(std::move(listener));
+
+  if (!timer.joinable()) {
+    timer = std::thread([this] { run(); });
+  }
+  condition.notify_all();
+  return id;
+}
+
+void TotpScheduler::unsubscribe(uint64_t id) {
+  std::unique_lock<std::mutex> lock(mutex);
+  subscriptions.erase(id);
+  if (std::this_thread::get_id() != timer.get_id()) {
+    condition.wait(lock, [&] { return delivering != id; });
+  }
+}
+
+size_t TotpScheduler::size() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return subscriptions.size();
+}
+
+uint64_t TotpScheduler::tick(Subscription &subscription, uint64_t nowMs,
+                             std::vector<Update> &updates) {
+  std::vector<const HMAC::Key *> keys;
+  std::vector<uint64_t> counters;
+  uint64_t wakeMs = UINT64_MAX;
+
+  for (size_t i = 0; i < subscription.entries.size(); ++i) {
+    const Entry &entry = subscription.entries[i];
+    uint64_t periodMs = entry.period * 1000;
+    uint64_t counter = nowMs / periodMs;
+    uint64_t boundaryMs = (counter + 1) * periodMs;
+    wakeMs = std::min(wakeMs, boundaryMs);
+
+    if (counter == subscription.counters[i]) {
+      continue;
+    }
+    subscription.counters[i] = counter;
+    keys.push_back(entry.key.get());
+    counters.push_back(counter);
+    // Rounded up, so a fresh code reports the full period.
+    updates.push_back(Update{i, 0, (boundaryMs - nowMs + 999) / 1000});
+  }
+
+  if (updates.empty()) {
+    return wakeMs;
+  }
+
+  std::vector<uint32_t> otps(keys.size());
+  HOTP::computeMany(keys.data(), counters.data(), keys.size(),
+                    subscription.digits, otps.data());
+  for (size_t i = 0; i < updates.size(); ++i) {
+    updates[i].otp = otps[i];
+  }
+  return wakeMs;
+}
+
+void TotpScheduler::run() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (!stopping) {
+    if (subscriptions.empty()) {
+      condition.wait(lock);
+      continue;
+    }
+
+    uint64_t nowMs = nowMilliseconds();
+    uint64_t wakeMs = UINT64_MAX;
+    std::vector<Delivery> deliveries;
+    for (auto &[id, subscription] : subscriptions) {
+      std::vector<Update> updates;
+      try {
+        wakeMs = std::min(wakeMs, tick(subscription, nowMs, updates));
+      } catch (...) {
+        continue;
+      }
+      if (!updates.empty()) {
+        deliveries.push_back({id, subscription.listener, std::move(updates)});
+      }
+    }
+
+    // Listeners run unlocked, so they can subscribe or unsubscribe; one
+    // removed by an earlier listener in this round is skipped.
+    for (const Delivery &delivery : deliveries) {
+      if (stopping) {
+        break;
+      }
+      if (subscriptions.count(delivery.id) == 0) {
+        continue;
+      }
+      delivering = delivery.id;
+      lock.unlock();
+      try {
+        (*delivery.listener)(delivery.updates);
+      } catch (...) {
+        // A failing listener must not stop the timer for everyone else.
+      }
+      lock.lock();
+      delivering = 0;
+      condition.notify_all();
+    }
+    if (stopping) {
+      break;
+    }
+
+    // Subscribing or unsubscribing wakes the timer early to reschedule. The
+    // entries are never empty, so wakeMs is only unset if every tick failed.
+    if (wakeMs == UINT64_MAX) {
+      condition.wait(lock);
+    } else {
+      condition.wait_until(
+          lock, Clock::time_point(std::chrono::milliseconds(wakeMs)));
+    }
+  }
+}
+
+} // namespace margelo::nitro::totp
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "../core/Hmac.hpp"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace margelo::nitro::totp {
+
+// Pushes TOTP codes to listeners as they change. A single native timer thread
+// sleeps until the next period boundary of any subscribed key, computes only
+// the codes whose time step advanced and hands them to the listener, so N
+// keys cost N HMACs per period regardless of how often the UI redraws.
+class TotpScheduler {
+public:
+  struct Entry {
+    std::shared_ptr<const HMAC::Key> key;
+    uint64_t period;
+  };
+
+  struct Update {
+    size_t index;
+    uint32_t otp;
+    uint64_t secondsRemaining;
+  };
+
+  // Called on the timer thread without the scheduler locked, so it may
+  // subscribe or unsubscribe. It should return quickly: updates for every
+  // other subscription wait until it does.
+  using Listener = std::function<void(const std::vector<Update> &)>;
+
+  // Longest accepted period, which keeps period boundaries in milliseconds
+  // far from overflowing the clock.
+  static constexpr uint64_t MAX_PERIOD = UINT32_MAX;
+
+  TotpScheduler() = default;
+  ~TotpScheduler();
+
+  TotpScheduler(const TotpScheduler &) = delete;
+  TotpScheduler &operator=(const TotpScheduler &) = delete;
+
+  // Process-wide scheduler used by the TOTP hybrid object.
+  static TotpScheduler &shared();
+
+  // Registers `entries` and returns a subscription id (never 0). The first
+  // update, carrying every code, is delivered right away on the timer thread.
+  // Throws if `entries` is empty.
+  uint64_t subscribe(std::vector<Entry> entries, int digits,
+                     Listener listener);
+
+  // No update is delivered for `id` once this returns; a delivery already
+  // in progress is waited for, unless this is called from its listener.
+  void unsubscribe(uint64_t id);
+
+  size_t size() const;
+
+private:
+  struct Subscription {
+    std::vector<Entry> entries;
+    int digits;
+    // Last time step delivered per entry; UINT64_MAX before the first one.
+    std::vector<uint64_t> counters;
+    std::shared_ptr<const Listener> listener;
+  };
+
+  struct Delivery {
+    uint64_t id;
+    std::shared_ptr<const Listener> listener;
+    std::vector<Update> updates;
+  };
+
+  void run();
+  // Computes the codes that changed at `nowMs` into `updates` and returns
+  // the earliest upcoming period boundary in milliseconds.
+  uint64_t tick(Subscription &subscription, uint64_t nowMs,
+                std::vector<Update> &updates);
+
+  mutable std::mutex mutex;
+  std::condition_variable condition;
+  std::map<uint64_t, Subscription> subscriptions;
+  uint64_t nextId = 1;
+  // Subscription whose listener is running, or 0.
+  uint64_t delivering = 0;
+  bool stopping = false;
+  std::thread timer;
+};
+
+} // namespace margelo::nitro::totp
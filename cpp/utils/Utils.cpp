@@ -1,14 +1,20 @@
 #include "Utils.hpp"
-#include <iomanip>
-#include <sstream>
+#include "ThreadPool.hpp"
+#include "WindowSearch.hpp"
+#include "../core/Hotp.hpp"
+#include "../core/Secret.hpp"
+#include "../core/SecureMemory.hpp"
+#include <cmath>
+#include <cstring>
 #include <stdexcept>
 
 namespace margelo::nitro::totp {
 
 std::string Utils::formatOtp(uint32_t otp, int digits) {
-  std::ostringstream ss;
-  ss << std::setw(digits) << std::setfill('0') << otp;
-  return ss.str();
+  // At most 10 characters, which stays within the small-string buffer.
+  std::string result(static_cast<size_t>(digits), '0');
+  HOTP::format(otp, digits, result.data());
+  return result;
 }
 
 std::string Utils::getAlgorithmName(SupportedAlgorithm algorithm) {
@@ -24,4 +30,157 @@ std::string Utils::getAlgorithmName(SupportedAlgorithm algorithm) {
   }
 }
 
+HMAC::Algorithm Utils::getHmacAlgorithm(SupportedAlgorithm algorithm) {
+  switch (algorithm) {
+  case SupportedAlgorithm::SHA1:
+    return HMAC::Algorithm::SHA1;
+  case SupportedAlgorithm::SHA256:
+    return HMAC::Algorithm::SHA256;
+  case SupportedAlgorithm::SHA512:
+    return HMAC::Algorithm::SHA512;
+  default:
+    throw std::runtime_error("Unsupported algorithm");
+  }
+}
+
+SupportedAlgorithm Utils::getSupportedAlgorithm(HMAC::Algorithm algorithm) {
+  switch (algorithm) {
+  case HMAC::Algorithm::SHA1:
+    return SupportedAlgorithm::SHA1;
+  case HMAC::Algorithm::SHA256:
+    return SupportedAlgorithm::SHA256;
+  case HMAC::Algorithm::SHA512:
+    return SupportedAlgorithm::SHA512;
+  default:
+    throw std::runtime_error("Unsupported algorithm");
+  }
+}
+
+int Utils::getWindow(double window) {
+  if (!(window >= 0.0 && window <= HOTP::MAX_WINDOW) ||
+      window != std::floor(window)) {
+    throw std::runtime_error("Window must be an integer between 0 and " +
+                             std::to_string(HOTP::MAX_WINDOW));
+  }
+  return static_cast<int>(window);
+}
+
+std::shared_ptr<const HMAC::Key> Utils::getKey(const SecretOrKey &secret,
+                                               HMAC::Algorithm algorithm) {
+  if (const std::string *base32 = std::get_if<std::string>(&secret)) {
+    return KeyCache::shared().get(*base32, algorithm);
+  }
+  if (const auto *bytes =
+          std::get_if<std::shared_ptr<ArrayBuffer>>(&secret)) {
+    return prepareKey(*bytes, algorithm);
+  }
+
+  auto handle = std::dynamic_pointer_cast<HybridNitroTotpKey>(
+      std::get<std::shared_ptr<HybridNitroTotpKeySpec>>(secret));
+  if (!handle) {
+    throw std::runtime_error("Invalid NitroTotpKey");
+  }
+  return handle->getKey();
+}
+
+std::shared_ptr<const HMAC::Key>
+Utils::prepareKey(const std::shared_ptr<ArrayBuffer> &bytes,
+                  HMAC::Algorithm algorithm) {
+  if (!bytes || bytes->size() == 0) {
+    throw std::runtime_error("Secret is empty");
+  }
+  return std::make_shared<const HMAC::Key>(algorithm, bytes->data(),
+                                           bytes->size());
+}
+
+SecretOrKey Utils::toOwned(const SecretOrKey &secret) {
+  const auto *bytes = std::get_if<std::shared_ptr<ArrayBuffer>>(&secret);
+  if (!bytes || !*bytes || (*bytes)->isOwner()) {
+    return secret;
+  }
+  size_t size = (*bytes)->size();
+  uint8_t *copy = new uint8_t[size];
+  if (size > 0) {
+    std::memcpy(copy, (*bytes)->data(), size);
+  }
+  return ArrayBuffer::wrap(copy, size, [copy, size]() {
+    SecureMemory::wipe(copy, size);
+    delete[] copy;
+  });
+}
+
+NitroKeyCacheStats Utils::toNitroKeyCacheStats(const KeyCache::Stats &stats) {
+  return NitroKeyCacheStats(static_cast<double>(stats.hits),
+                            static_cast<double>(stats.misses),
+                            static_cast<double>(stats.evictions),
+                            static_cast<double>(stats.size),
+                            static_cast<double>(stats.capacity));
+}
+
+std::string Utils::generateOtp(const SecretOrKey &secret,
+                               HMAC::Algorithm algorithm, uint64_t counter,
+                               int digits) {
+  std::shared_ptr<const HMAC::Key> key = getKey(secret, algorithm);
+
+  uint32_t otp = HOTP::compute(*key, counter, digits);
+
+  return formatOtp(otp, digits);
+}
+
+std::vector<std::string>
+Utils::generateOtps(const std::vector<std::string> &secrets,
+                    HMAC::Algorithm algorithm, uint64_t counter, int digits) {
+  std::vector<std::unique_ptr<HMAC::Key>> keys;
+  std::vector<const HMAC::Key *> keyPointers;
+  keys.reserve(secrets.size());
+  keyPointers.reserve(secrets.size());
+  for (const std::string &secret : secrets) {
+    const Secret decoded = Secret::fromBase32(secret);
+    const SecureKey &bytes = decoded.getBytes();
+    keys.push_back(
+        std::make_unique<HMAC::Key>(algorithm, bytes.data(), bytes.size()));
+    keyPointers.push_back(keys.back().get());
+  }
+
+  // Every secret shares the counter, so the HMACs run several lanes at once.
+  std::vector<uint64_t> counters(secrets.size(), counter);
+  std::vector<uint32_t> otps(secrets.size());
+  HOTP::computeMany(keyPointers.data(), counters.data(), secrets.size(),
+                    digits, otps.data());
+
+  std::vector<std::string> result;
+  result.reserve(secrets.size());
+  for (uint32_t otp : otps) {
+    result.push_back(formatOtp(otp, digits));
+  }
+
+  return result;
+}
+
+std::optional<int> Utils::findOtp(const SecretOrKey &secret,
+                                  const std::string &otp,
+                                  HMAC::Algorithm algorithm, uint64_t counter,
+                                  int window, int digits, bool parallel,
+                                  bool constantTime) {
+  // Parse the submitted code once; candidates are compared as integers.
+  uint32_t expected = 0;
+  if (!HOTP::parse(otp, digits, expected)) {
+    return std::nullopt;
+  }
+
+  // The key is decoded and its HMAC state prepared once for the whole window.
+  std::shared_ptr<const HMAC::Key> key = getKey(secret, algorithm);
+
+  // Scans the whole window even after a match, so it is never split up.
+  if (constantTime) {
+    return HOTP::findConstantTime(*key, counter, window, digits, expected);
+  }
+
+  if (parallel) {
+    return WindowSearch::find(ThreadPool::shared(), *key, counter, window,
+                              digits, expected);
+  }
+  return HOTP::find(*key, counter, window, digits, expected);
+}
+
 } // namespace margelo::nitro::totp
@@ -1,12 +1,58 @@
 #pragma once
 
+#include "../core/Hmac.hpp"
+#include "../core/KeyCache.hpp"
+#include "../hybrid/HybridNitroTotpKey.hpp"
 #include "HybridNitroTotpSpec.hpp"
+#include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 namespace margelo::nitro::totp {
 class Utils {
 public:
   static std::string formatOtp(uint32_t otp, int digits);
   static std::string getAlgorithmName(SupportedAlgorithm algorithm);
+  static HMAC::Algorithm getHmacAlgorithm(SupportedAlgorithm algorithm);
+  static SupportedAlgorithm getSupportedAlgorithm(HMAC::Algorithm algorithm);
+  // `window` from validation options as an int, checked before any
+  // arithmetic on it. Throws unless it is an integer in
+  // 0 .. HOTP::MAX_WINDOW.
+  static int getWindow(double window);
+  // Resolves a secret string through the shared key cache. Key handles
+  // carry their own algorithm, so `algorithm` only applies to strings and
+  // raw bytes.
+  static std::shared_ptr<const HMAC::Key> getKey(const SecretOrKey &secret,
+                                                 HMAC::Algorithm algorithm);
+  // Keys raw secret bytes where they are, without decoding or caching them.
+  static std::shared_ptr<const HMAC::Key>
+  prepareKey(const std::shared_ptr<ArrayBuffer> &bytes,
+             HMAC::Algorithm algorithm);
+  // ArrayBuffers from JS may only be read on the JS thread, so async methods
+  // pass their secret through this before queueing work. Raw bytes are
+  // copied into a native buffer that is wiped when released.
+  static SecretOrKey toOwned(const SecretOrKey &secret);
+  static NitroKeyCacheStats
+  toNitroKeyCacheStats(const KeyCache::Stats &stats);
+  // HOTP code of `counter` for `secret`. TOTP passes its time step as the
+  // counter, so both hybrid objects generate through these helpers.
+  static std::string generateOtp(const SecretOrKey &secret,
+                                 HMAC::Algorithm algorithm, uint64_t counter,
+                                 int digits);
+  // generateOtp() for Base32 secrets sharing one counter; the HMACs run
+  // several lanes at once.
+  static std::vector<std::string>
+  generateOtps(const std::vector<std::string> &secrets,
+               HMAC::Algorithm algorithm, uint64_t counter, int digits);
+  // Offset of the counter within `window` steps of `counter` whose code is
+  // `otp`, if any; the one closest to `counter` when several match.
+  // `parallel` splits large windows over the shared thread pool,
+  // `constantTime` scans the whole window without early exit.
+  static std::optional<int> findOtp(const SecretOrKey &secret,
+                                    const std::string &otp,
+                                    HMAC::Algorithm algorithm,
+                                    uint64_t counter, int window, int digits,
+                                    bool parallel, bool constantTime);
 };
 } // namespace margelo::nitro::totp
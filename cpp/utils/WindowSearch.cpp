@@ -0,0 +1,46 @@
+#include "WindowSearch.hpp"
+#include "../core/Hotp.hpp"
+#include <algorithm>
+#include <atomic>
+
+namespace margelo::nitro::totp {
+
+std::optional<int> WindowSearch::find(ThreadPool &pool, const HMAC::Key &key,
+                                      uint64_t counter, int window,
+                                      int digits, uint32_t otp) {
+  // The serial scan also throws for windows outside 0 .. MAX_WINDOW.
+  if (window < PARALLEL_MIN_CANDIDATES / 2 || window > HOTP::MAX_WINDOW ||
+      pool.size() < 2) {
+    return HOTP::find(key, counter, window, digits, otp);
+  }
+
+  // `bound` holds the lowest matching candidate index seen so far, so
+  // ranges past it stop early.
+  int candidates = 2 * window + 1;
+  size_t parts = std::min<size_t>(pool.size() + 1,
+                                  candidates / (PARALLEL_MIN_CANDIDATES / 2));
+  std::atomic<int> bound(candidates - 1);
+  std::atomic<bool> found(false);
+
+  pool.parallelFor(parts, [&](size_t part) {
+    int first = static_cast<int>(part * candidates / parts);
+    int last = static_cast<int>((part + 1) * candidates / parts) - 1;
+
+    std::optional<int> match =
+        HOTP::find(key, counter, first, last, digits, otp, &bound);
+    if (match) {
+      int current = bound.load();
+      while (*match < current &&
+             !bound.compare_exchange_weak(current, *match)) {
+      }
+      found = true;
+    }
+  });
+
+  if (!found) {
+    return std::nullopt;
+  }
+  return HOTP::candidateOffset(bound.load());
+}
+
+} // namespace margelo::nitro::totp
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "../core/Hmac.hpp"
+#include "ThreadPool.hpp"
+#include <cstdint>
+#include <optional>
+
+namespace margelo::nitro::totp {
+
+// Validation window searches spread over a thread pool, for HOTP resync
+// windows of hundreds or thousands of counters.
+class WindowSearch {
+public:
+  // Smaller windows are cheaper to scan than to hand out to workers.
+  static constexpr int PARALLEL_MIN_CANDIDATES = 256;
+
+  // HOTP::find() with the candidates split into contiguous ranges of its
+  // search order, scanned by the workers of `pool` and the calling thread.
+  // A match found in one range stops the ranges after it, and the result is
+  // the offset the serial scan returns. Small windows, and pools of fewer
+  // than two workers, are scanned on the calling thread.
+  static std::optional<int> find(ThreadPool &pool, const HMAC::Key &key,
+                                 uint64_t counter, int window, int digits,
+                                 uint32_t otp);
+};
+
+} // namespace margelo::nitro::totp
@@ -34,7 +34,10 @@ target_sources(
   ../nitrogen/generated/android/NitroTotpOnLoad.cpp
   # Shared Nitrogen C++ sources
   ../nitrogen/generated/shared/c++/HybridNitroHotpSpec.cpp
+  ../nitrogen/generated/shared/c++/HybridNitroKeyVaultSpec.cpp
+  ../nitrogen/generated/shared/c++/HybridNitroOtpAuthSpec.cpp
   ../nitrogen/generated/shared/c++/HybridNitroSecretSpec.cpp
+  ../nitrogen/generated/shared/c++/HybridNitroTotpKeySpec.cpp
   ../nitrogen/generated/shared/c++/HybridNitroTotpSpec.cpp
   # Android-specific Nitrogen C++ sources
   
@@ -18,6 +18,7 @@
 #include "HybridNitroTotp.hpp"
 #include "HybridNitroHotp.hpp"
 #include "HybridNitroSecret.hpp"
+#include "HybridNitroOtpAuth.hpp"
 
 namespace margelo::nitro::totp {
 
@@ -58,6 +59,15 @@ int initialize(JavaVM* vm) {
         return std::make_shared<HybridNitroSecret>();
       }
     );
+    HybridObjectRegistry::registerHybridObjectConstructor(
+      "NitroOtpAuth",
+      []() -> std::shared_ptr<HybridObject> {
+        static_assert(std::is_default_constructible_v<HybridNitroOtpAuth>,
+                      "The HybridObject \"HybridNitroOtpAuth\" is not default-constructible! "
+                      "Create a public constructor that takes zero arguments to be able to autolink this HybridObject.");
+        return std::make_shared<HybridNitroOtpAuth>();
+      }
+    );
   });
 }
 
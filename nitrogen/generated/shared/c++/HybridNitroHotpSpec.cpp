@@ -15,7 +15,15 @@ namespace margelo::nitro::totp {
     // load custom methods/properties
     registerHybrids(this, [](Prototype& prototype) {
       prototype.registerHybridMethod("generate", &HybridNitroHotpSpec::generate);
+      prototype.registerHybridMethod("generateAsync", &HybridNitroHotpSpec::generateAsync);
+      prototype.registerHybridMethod("generateMany", &HybridNitroHotpSpec::generateMany);
+      prototype.registerHybridMethod("generateManyAsync", &HybridNitroHotpSpec::generateManyAsync);
       prototype.registerHybridMethod("validate", &HybridNitroHotpSpec::validate);
+      prototype.registerHybridMethod("validateAsync", &HybridNitroHotpSpec::validateAsync);
+      prototype.registerHybridMethod("validateDelta", &HybridNitroHotpSpec::validateDelta);
+      prototype.registerHybridMethod("validateDeltaAsync", &HybridNitroHotpSpec::validateDeltaAsync);
+      prototype.registerHybridMethod("getKeyCacheStats", &HybridNitroHotpSpec::getKeyCacheStats);
+      prototype.registerHybridMethod("clearKeyCache", &HybridNitroHotpSpec::clearKeyCache);
     });
   }
 
@@ -13,14 +13,26 @@
 #error NitroModules cannot be found! Are you sure you installed NitroModules properly?
 #endif
 
+// Forward declaration of `HybridNitroTotpKeySpec` to properly resolve imports.
+namespace margelo::nitro::totp { class HybridNitroTotpKeySpec; }
 // Forward declaration of `NitroHotpGenerateOptions` to properly resolve imports.
 namespace margelo::nitro::totp { struct NitroHotpGenerateOptions; }
 // Forward declaration of `NitroHotpValidateOptions` to properly resolve imports.
 namespace margelo::nitro::totp { struct NitroHotpValidateOptions; }
+// Forward declaration of `NitroKeyCacheStats` to properly resolve imports.
+namespace margelo::nitro::totp { struct NitroKeyCacheStats; }
 
 #include <string>
+#include <memory>
+#include "HybridNitroTotpKeySpec.hpp"
+#include <NitroModules/ArrayBuffer.hpp>
+#include <variant>
+#include <NitroModules/Promise.hpp>
+#include <vector>
+#include <optional>
 #include "NitroHotpGenerateOptions.hpp"
 #include "NitroHotpValidateOptions.hpp"
+#include "NitroKeyCacheStats.hpp"
 
 namespace margelo::nitro::totp {
 
@@ -53,8 +65,16 @@ namespace margelo::nitro::totp {
 
     public:
       // Methods
-      virtual std::string generate(const std::string& secret, const NitroHotpGenerateOptions& options) = 0;
-      virtual bool validate(const std::string& secret, const std::string& otp, const NitroHotpValidateOptions& options) = 0;
+      virtual std::string generate(const std::variant<std::string, std::shared_ptr<HybridNitroTotpKeySpec>, std::shared_ptr<ArrayBuffer>>& secret, const NitroHotpGenerateOptions& options) = 0;
+      virtual std::shared_ptr<Promise<std::string>> generateAsync(const std::variant<std::string, std::shared_ptr<HybridNitroTotpKeySpec>, std::shared_ptr<ArrayBuffer>>& secret, const NitroHotpGenerateOptions& options) = 0;
+      virtual std::vector<std::string> generateMany(const std::vector<std::string>& secrets, const NitroHotpGenerateOptions& options) = 0;
+      virtual std::shared_ptr<Promise<std::vector<std::string>>> generateManyAsync(const std::vector<std::string>& secrets, const NitroHotpGenerateOptions& options) = 0;
+      virtual bool validate(const std::variant<std::string, std::shared_ptr<HybridNitroTotpKeySpec>, std::shared_ptr<ArrayBuffer>>& secret, const std::string& otp, const NitroHotpValidateOptions& options) = 0;
+      virtual std::shared_ptr<Promise<bool>> validateAsync(const std::variant<std::string, std::shared_ptr<HybridNitroTotpKeySpec>, std::shared_ptr<ArrayBuffer>>& secret, const std::string& otp, const NitroHotpValidateOptions& options) = 0;
+      virtual std::optional<double> validateDelta(const std::variant<std::string, std::shared_ptr<HybridNitroTotpKeySpec>, std::shared_ptr<ArrayBuffer>>& secret, const std::string& otp, const NitroHotpValidateOptions& options) = 0;
+      virtual std::shared_ptr<Promise<std::optional<double>>> validateDeltaAsync(const std::variant<std::string, std::shared_ptr<HybridNitroTotpKeySpec>, std::shared_ptr<ArrayBuffer>>& secret, const std::string& otp, const NitroHotpValidateOptions& options) = 0;
+      virtual NitroKeyCacheStats getKeyCacheStats() = 0;
+      virtual void clearKeyCache() = 0;
 
     protected:
       // Hybrid Setup
@@ -0,0 +1,26 @@
+///
+/// HybridNitroKeyVaultSpec.cpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#include "HybridNitroKeyVaultSpec.hpp"
+
+namespace margelo::nitro::totp {
+
+  void HybridNitroKeyVaultSpec::loadHybridMethods() {
+    // load base methods/properties
+    HybridObject::loadHybridMethods();
+    // load custom methods/properties
+    registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridGetter("size", &HybridNitroKeyVaultSpec::getSize);
+      prototype.registerHybridMethod("indexOf", &HybridNitroKeyVaultSpec::indexOf);
+      prototype.registerHybridMethod("getEntry", &HybridNitroKeyVaultSpec::getEntry);
+      prototype.registerHybridMethod("createKey", &HybridNitroKeyVaultSpec::createKey);
+      prototype.registerHybridMethod("generate", &HybridNitroKeyVaultSpec::generate);
+      prototype.registerHybridMethod("close", &HybridNitroKeyVaultSpec::close);
+    });
+  }
+
+} // namespace margelo::nitro::totp
@@ -0,0 +1,72 @@
+///
+/// HybridNitroKeyVaultSpec.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/HybridObject.hpp>)
+#include <NitroModules/HybridObject.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `NitroKeyVaultEntry` to properly resolve imports.
+namespace margelo::nitro::totp { struct NitroKeyVaultEntry; }
+// Forward declaration of `HybridNitroTotpKeySpec` to properly resolve imports.
+namespace margelo::nitro::totp { class HybridNitroTotpKeySpec; }
+
+#include "NitroKeyVaultEntry.hpp"
+#include <memory>
+#include "HybridNitroTotpKeySpec.hpp"
+#include <string>
+
+namespace margelo::nitro::totp {
+
+  using namespace margelo::nitro;
+
+  /**
+   * An abstract base class for `NitroKeyVault`
+   * Inherit this class to create instances of `HybridNitroKeyVaultSpec` in C++.
+   * You must explicitly call `HybridObject`'s constructor yourself, because it is virtual.
+   * @example
+   * ```cpp
+   * class HybridNitroKeyVault: public HybridNitroKeyVaultSpec {
+   * public:
+   *   HybridNitroKeyVault(...): HybridObject(TAG) { ... }
+   *   // ...
+   * };
+   * ```
+   */
+  class HybridNitroKeyVaultSpec: public virtual HybridObject {
+    public:
+      // Constructor
+      explicit HybridNitroKeyVaultSpec(): HybridObject(TAG) { }
+
+      // Destructor
+      ~HybridNitroKeyVaultSpec() override = default;
+
+    public:
+      // Properties
+      virtual double getSize() = 0;
+
+    public:
+      // Methods
+      virtual double indexOf(double id) = 0;
+      virtual NitroKeyVaultEntry getEntry(double index) = 0;
+      virtual std::shared_ptr<HybridNitroTotpKeySpec> createKey(double index) = 0;
+      virtual std::string generate(double index, double currentTime) = 0;
+      virtual void close() = 0;
+
+    protected:
+      // Hybrid Setup
+      void loadHybridMethods() override;
+
+    protected:
+      // Tag for logging
+      static constexpr auto TAG = "NitroKeyVault";
+  };
+
+} // namespace margelo::nitro::totp
@@ -0,0 +1,24 @@
+///
+/// HybridNitroOtpAuthSpec.cpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#include "HybridNitroOtpAuthSpec.hpp"
+
+namespace margelo::nitro::totp {
+
+  void HybridNitroOtpAuthSpec::loadHybridMethods() {
+    // load base methods/properties
+    HybridObject::loadHybridMethods();
+    // load custom methods/properties
+    registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridMethod("parse", &HybridNitroOtpAuthSpec::parse);
+      prototype.registerHybridMethod("parseMany", &HybridNitroOtpAuthSpec::parseMany);
+      prototype.registerHybridMethod("build", &HybridNitroOtpAuthSpec::build);
+      prototype.registerHybridMethod("parseMigration", &HybridNitroOtpAuthSpec::parseMigration);
+    });
+  }
+
+} // namespace margelo::nitro::totp
@@ -0,0 +1,72 @@
+///
+/// HybridNitroOtpAuthSpec.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/HybridObject.hpp>)
+#include <NitroModules/HybridObject.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `NitroOtpAuthURI` to properly resolve imports.
+namespace margelo::nitro::totp { struct NitroOtpAuthURI; }
+// Forward declaration of `NitroOtpAuthAccount` to properly resolve imports.
+namespace margelo::nitro::totp { struct NitroOtpAuthAccount; }
+
+#include "NitroOtpAuthURI.hpp"
+#include <string>
+#include <vector>
+#include <optional>
+#include "NitroOtpAuthAccount.hpp"
+
+namespace margelo::nitro::totp {
+
+  using namespace margelo::nitro;
+
+  /**
+   * An abstract base class for `NitroOtpAuth`
+   * Inherit this class to create instances of `HybridNitroOtpAuthSpec` in C++.
+   * You must explicitly call `HybridObject`'s constructor yourself, because it is virtual.
+   * @example
+   * ```cpp
+   * class HybridNitroOtpAuth: public HybridNitroOtpAuthSpec {
+   * public:
+   *   HybridNitroOtpAuth(...): HybridObject(TAG) { ... }
+   *   // ...
+   * };
+   * ```
+   */
+  class HybridNitroOtpAuthSpec: public virtual HybridObject {
+    public:
+      // Constructor
+      explicit HybridNitroOtpAuthSpec(): HybridObject(TAG) { }
+
+      // Destructor
+      ~HybridNitroOtpAuthSpec() override = default;
+
+    public:
+      // Properties
+      
+
+    public:
+      // Methods
+      virtual NitroOtpAuthURI parse(const std::string& uri) = 0;
+      virtual std::vector<std::optional<NitroOtpAuthURI>> parseMany(const std::vector<std::string>& uris) = 0;
+      virtual std::string build(const NitroOtpAuthURI& uri, bool issuerInLabel) = 0;
+      virtual std::vector<NitroOtpAuthAccount> parseMigration(const std::string& uri) = 0;
+
+    protected:
+      // Hybrid Setup
+      void loadHybridMethods() override;
+
+    protected:
+      // Tag for logging
+      static constexpr auto TAG = "NitroOtpAuth";
+  };
+
+} // namespace margelo::nitro::totp
@@ -15,6 +15,13 @@ namespace margelo::nitro::totp {
     // load custom methods/properties
     registerHybrids(this, [](Prototype& prototype) {
       prototype.registerHybridMethod("generate", &HybridNitroSecretSpec::generate);
+      prototype.registerHybridMethod("generateAsync", &HybridNitroSecretSpec::generateAsync);
+      prototype.registerHybridMethod("generateMany", &HybridNitroSecretSpec::generateMany);
+      prototype.registerHybridMethod("generateManyAsync", &HybridNitroSecretSpec::generateManyAsync);
+      prototype.registerHybridMethod("generateBytes", &HybridNitroSecretSpec::generateBytes);
+      prototype.registerHybridMethod("createKey", &HybridNitroSecretSpec::createKey);
+      prototype.registerHybridMethod("openVault", &HybridNitroSecretSpec::openVault);
+      prototype.registerHybridMethod("writeVault", &HybridNitroSecretSpec::writeVault);
     });
   }
 
@@ -15,9 +15,26 @@
 
 // Forward declaration of `GenerateSecretKeyOptions` to properly resolve imports.
 namespace margelo::nitro::totp { struct GenerateSecretKeyOptions; }
+// Forward declaration of `HybridNitroTotpKeySpec` to properly resolve imports.
+namespace margelo::nitro::totp { class HybridNitroTotpKeySpec; }
+// Forward declaration of `SupportedAlgorithm` to properly resolve imports.
+namespace margelo::nitro::totp { enum class SupportedAlgorithm; }
+// Forward declaration of `HybridNitroKeyVaultSpec` to properly resolve imports.
+namespace margelo::nitro::totp { class HybridNitroKeyVaultSpec; }
+// Forward declaration of `NitroKeyVaultRecord` to properly resolve imports.
+namespace margelo::nitro::totp { struct NitroKeyVaultRecord; }
 
 #include <string>
 #include "GenerateSecretKeyOptions.hpp"
+#include <NitroModules/Promise.hpp>
+#include <memory>
+#include <NitroModules/ArrayBuffer.hpp>
+#include "HybridNitroTotpKeySpec.hpp"
+#include <variant>
+#include "SupportedAlgorithm.hpp"
+#include "HybridNitroKeyVaultSpec.hpp"
+#include <vector>
+#include "NitroKeyVaultRecord.hpp"
 
 namespace margelo::nitro::totp {
 
@@ -51,6 +68,13 @@ namespace margelo::nitro::totp {
     public:
       // Methods
       virtual std::string generate(const GenerateSecretKeyOptions& options) = 0;
+      virtual std::shared_ptr<Promise<std::string>> generateAsync(const GenerateSecretKeyOptions& options) = 0;
+      virtual std::vector<std::string> generateMany(double count, const GenerateSecretKeyOptions& options) = 0;
+      virtual std::shared_ptr<Promise<std::vector<std::string>>> generateManyAsync(double count, const GenerateSecretKeyOptions& options) = 0;
+      virtual std::shared_ptr<ArrayBuffer> generateBytes(const GenerateSecretKeyOptions& options) = 0;
+      virtual std::shared_ptr<HybridNitroTotpKeySpec> createKey(const std::variant<std::string, std::shared_ptr<ArrayBuffer>>& secret, SupportedAlgorithm algorithm) = 0;
+      virtual std::shared_ptr<HybridNitroKeyVaultSpec> openVault(const std::string& path) = 0;
+      virtual void writeVault(const std::string& path, const std::vector<NitroKeyVaultRecord>& records) = 0;
 
     protected:
       // Hybrid Setup
@@ -0,0 +1,21 @@
+///
+/// HybridNitroTotpKeySpec.cpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#include "HybridNitroTotpKeySpec.hpp"
+
+namespace margelo::nitro::totp {
+
+  void HybridNitroTotpKeySpec::loadHybridMethods() {
+    // load base methods/properties
+    HybridObject::loadHybridMethods();
+    // load custom methods/properties
+    registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridGetter("algorithm", &HybridNitroTotpKeySpec::getAlgorithm);
+    });
+  }
+
+} // namespace margelo::nitro::totp
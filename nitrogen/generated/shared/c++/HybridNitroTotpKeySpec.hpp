@@ -0,0 +1,63 @@
+///
+/// HybridNitroTotpKeySpec.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/HybridObject.hpp>)
+#include <NitroModules/HybridObject.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `SupportedAlgorithm` to properly resolve imports.
+namespace margelo::nitro::totp { enum class SupportedAlgorithm; }
+
+#include "SupportedAlgorithm.hpp"
+
+namespace margelo::nitro::totp {
+
+  using namespace margelo::nitro;
+
+  /**
+   * An abstract base class for `NitroTotpKey`
+   * Inherit this class to create instances of `HybridNitroTotpKeySpec` in C++.
+   * You must explicitly call `HybridObject`'s constructor yourself, because it is virtual.
+   * @example
+   * ```cpp
+   * class HybridNitroTotpKey: public HybridNitroTotpKeySpec {
+   * public:
+   *   HybridNitroTotpKey(...): HybridObject(TAG) { ... }
+   *   // ...
+   * };
+   * ```
+   */
+  class HybridNitroTotpKeySpec: public virtual HybridObject {
+    public:
+      // Constructor
+      explicit HybridNitroTotpKeySpec(): HybridObject(TAG) { }
+
+      // Destructor
+      ~HybridNitroTotpKeySpec() override = default;
+
+    public:
+      // Properties
+      virtual SupportedAlgorithm getAlgorithm() = 0;
+
+    public:
+      // Methods
+      
+
+    protected:
+      // Hybrid Setup
+      void loadHybridMethods() override;
+
+    protected:
+      // Tag for logging
+      static constexpr auto TAG = "NitroTotpKey";
+  };
+
+} // namespace margelo::nitro::totp
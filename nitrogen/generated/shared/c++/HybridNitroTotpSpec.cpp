@@ -15,7 +15,20 @@ namespace margelo::nitro::totp {
     // load custom methods/properties
     registerHybrids(this, [](Prototype& prototype) {
       prototype.registerHybridMethod("generate", &HybridNitroTotpSpec::generate);
+      prototype.registerHybridMethod("generateAsync", &HybridNitroTotpSpec::generateAsync);
+      prototype.registerHybridMethod("generateMany", &HybridNitroTotpSpec::generateMany);
+      prototype.registerHybridMethod("generateManyAsync", &HybridNitroTotpSpec::generateManyAsync);
       prototype.registerHybridMethod("validate", &HybridNitroTotpSpec::validate);
+      prototype.registerHybridMethod("validateAsync", &HybridNitroTotpSpec::validateAsync);
+      prototype.registerHybridMethod("validateDelta", &HybridNitroTotpSpec::validateDelta);
+      prototype.registerHybridMethod("validateDeltaAsync", &HybridNitroTotpSpec::validateDeltaAsync);
+      prototype.registerHybridMethod("validateMany", &HybridNitroTotpSpec::validateMany);
+      prototype.registerHybridMethod("validateManyAsync", &HybridNitroTotpSpec::validateManyAsync);
+      prototype.registerHybridMethod("getKeyCacheStats", &HybridNitroTotpSpec::getKeyCacheStats);
+      prototype.registerHybridMethod("clearKeyCache", &HybridNitroTotpSpec::clearKeyCache);
+      prototype.registerHybridMethod("subscribe", &HybridNitroTotpSpec::subscribe);
+      prototype.registerHybridMethod("unsubscribe", &HybridNitroTotpSpec::unsubscribe);
+      prototype.registerHybridMethod("precompute", &HybridNitroTotpSpec::precompute);
     });
   }
 
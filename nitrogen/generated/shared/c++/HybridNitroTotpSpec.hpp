@@ -13,14 +13,30 @@
 #error NitroModules cannot be found! Are you sure you installed NitroModules properly?
 #endif
 
+// Forward declaration of `HybridNitroTotpKeySpec` to properly resolve imports.
+namespace margelo::nitro::totp { class HybridNitroTotpKeySpec; }
 // Forward declaration of `NitroTotpGenerateOptions` to properly resolve imports.
 namespace margelo::nitro::totp { struct NitroTotpGenerateOptions; }
 // Forward declaration of `NitroTotpValidateOptions` to properly resolve imports.
 namespace margelo::nitro::totp { struct NitroTotpValidateOptions; }
+// Forward declaration of `NitroKeyCacheStats` to properly resolve imports.
+namespace margelo::nitro::totp { struct NitroKeyCacheStats; }
+// Forward declaration of `NitroTotpCodeUpdate` to properly resolve imports.
+namespace margelo::nitro::totp { struct NitroTotpCodeUpdate; }
 
 #include <string>
+#include <memory>
+#include "HybridNitroTotpKeySpec.hpp"
+#include <NitroModules/ArrayBuffer.hpp>
+#include <variant>
+#include <NitroModules/Promise.hpp>
+#include <vector>
+#include <optional>
 #include "NitroTotpGenerateOptions.hpp"
 #include "NitroTotpValidateOptions.hpp"
+#include "NitroKeyCacheStats.hpp"
+#include "NitroTotpCodeUpdate.hpp"
+#include <functional>
 
 namespace margelo::nitro::totp {
 
@@ -53,8 +69,21 @@ namespace margelo::nitro::totp {
 
     public:
       // Methods
-      virtual std::string generate(const std::string& secret, const NitroTotpGenerateOptions& options) = 0;
-      virtual bool validate(const std::string& secret, const std::string& otp, const NitroTotpValidateOptions& options) = 0;
+      virtual std::string generate(const std::variant<std::string, std::shared_ptr<HybridNitroTotpKeySpec>, std::shared_ptr<ArrayBuffer>>& secret, const NitroTotpGenerateOptions& options) = 0;
+      virtual std::shared_ptr<Promise<std::string>> generateAsync(const std::variant<std::string, std::shared_ptr<HybridNitroTotpKeySpec>, std::shared_ptr<ArrayBuffer>>& secret, const NitroTotpGenerateOptions& options) = 0;
+      virtual std::vector<std::string> generateMany(const std::vector<std::string>& secrets, const NitroTotpGenerateOptions& options) = 0;
+      virtual std::shared_ptr<Promise<std::vector<std::string>>> generateManyAsync(const std::vector<std::string>& secrets, const NitroTotpGenerateOptions& options) = 0;
+      virtual bool validate(const std::variant<std::string, std::shared_ptr<HybridNitroTotpKeySpec>, std::shared_ptr<ArrayBuffer>>& secret, const std::string& otp, const NitroTotpValidateOptions& options) = 0;
+      virtual std::shared_ptr<Promise<bool>> validateAsync(const std::variant<std::string, std::shared_ptr<HybridNitroTotpKeySpec>, std::shared_ptr<ArrayBuffer>>& secret, const std::string& otp, const NitroTotpValidateOptions& options) = 0;
+      virtual std::optional<double> validateDelta(const std::variant<std::string, std::shared_ptr<HybridNitroTotpKeySpec>, std::shared_ptr<ArrayBuffer>>& secret, const std::string& otp, const NitroTotpValidateOptions& options) = 0;
+      virtual std::shared_ptr<Promise<std::optional<double>>> validateDeltaAsync(const std::variant<std::string, std::shared_ptr<HybridNitroTotpKeySpec>, std::shared_ptr<ArrayBuffer>>& secret, const std::string& otp, const NitroTotpValidateOptions& options) = 0;
+      virtual std::shared_ptr<ArrayBuffer> validateMany(const std::vector<std::variant<std::string, std::shared_ptr<HybridNitroTotpKeySpec>, std::shared_ptr<ArrayBuffer>>>& secrets, const std::vector<std::string>& otps, const NitroTotpValidateOptions& options) = 0;
+      virtual std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> validateManyAsync(const std::vector<std::variant<std::string, std::shared_ptr<HybridNitroTotpKeySpec>, std::shared_ptr<ArrayBuffer>>>& secrets, const std::vector<std::string>& otps, const NitroTotpValidateOptions& options) = 0;
+      virtual NitroKeyCacheStats getKeyCacheStats() = 0;
+      virtual void clearKeyCache() = 0;
+      virtual double subscribe(const std::vector<std::shared_ptr<HybridNitroTotpKeySpec>>& keys, const std::vector<double>& periods, double digits, const std::function<void(const std::vector<NitroTotpCodeUpdate>& /* updates */)>& onUpdate) = 0;
+      virtual void unsubscribe(double subscriptionId) = 0;
+      virtual void precompute(const std::shared_ptr<HybridNitroTotpKeySpec>& key, double count, const NitroTotpGenerateOptions& options) = 0;
 
     protected:
       // Hybrid Setup
@@ -32,13 +32,15 @@ namespace margelo::nitro::totp {
   struct NitroHotpValidateOptions {
   public:
     std::optional<double> counter     SWIFT_PRIVATE;
+    std::optional<bool> parallel     SWIFT_PRIVATE;
     std::optional<double> window     SWIFT_PRIVATE;
+    std::optional<bool> constantTime     SWIFT_PRIVATE;
     std::optional<double> digits     SWIFT_PRIVATE;
     std::optional<SupportedAlgorithm> algorithm     SWIFT_PRIVATE;
 
   public:
     NitroHotpValidateOptions() = default;
-    explicit NitroHotpValidateOptions(std::optional<double> counter, std::optional<double> window, std::optional<double> digits, std::optional<SupportedAlgorithm> algorithm): counter(counter), window(window), digits(digits), algorithm(algorithm) {}
+    explicit NitroHotpValidateOptions(std::optional<double> counter, std::optional<bool> parallel, std::optional<double> window, std::optional<bool> constantTime, std::optional<double> digits, std::optional<SupportedAlgorithm> algorithm): counter(counter), parallel(parallel), window(window), constantTime(constantTime), digits(digits), algorithm(algorithm) {}
   };
 
 } // namespace margelo::nitro::totp
@@ -52,7 +54,9 @@ namespace margelo::nitro {
       jsi::Object obj = arg.asObject(runtime);
       return margelo::nitro::totp::NitroHotpValidateOptions(
         JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "counter")),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "parallel")),
         JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "window")),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "constantTime")),
         JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "digits")),
         JSIConverter<std::optional<margelo::nitro::totp::SupportedAlgorithm>>::fromJSI(runtime, obj.getProperty(runtime, "algorithm"))
       );
@@ -60,7 +64,9 @@ namespace margelo::nitro {
     static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::totp::NitroHotpValidateOptions& arg) {
       jsi::Object obj(runtime);
       obj.setProperty(runtime, "counter", JSIConverter<std::optional<double>>::toJSI(runtime, arg.counter));
+      obj.setProperty(runtime, "parallel", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.parallel));
       obj.setProperty(runtime, "window", JSIConverter<std::optional<double>>::toJSI(runtime, arg.window));
+      obj.setProperty(runtime, "constantTime", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.constantTime));
       obj.setProperty(runtime, "digits", JSIConverter<std::optional<double>>::toJSI(runtime, arg.digits));
       obj.setProperty(runtime, "algorithm", JSIConverter<std::optional<margelo::nitro::totp::SupportedAlgorithm>>::toJSI(runtime, arg.algorithm));
       return obj;
@@ -71,7 +77,9 @@ namespace margelo::nitro {
       }
       jsi::Object obj = value.getObject(runtime);
       if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "counter"))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "parallel"))) return false;
       if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "window"))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "constantTime"))) return false;
       if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "digits"))) return false;
       if (!JSIConverter<std::optional<margelo::nitro::totp::SupportedAlgorithm>>::canConvert(runtime, obj.getProperty(runtime, "algorithm"))) return false;
       return true;
@@ -0,0 +1,89 @@
+///
+/// NitroKeyVaultRecord.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `SupportedAlgorithm` to properly resolve imports.
+namespace margelo::nitro::totp { enum class SupportedAlgorithm; }
+
+#include <string>
+#include "SupportedAlgorithm.hpp"
+
+namespace margelo::nitro::totp {
+
+  /**
+   * A struct which can be represented as a JavaScript object (NitroKeyVaultRecord).
+   */
+  struct NitroKeyVaultRecord {
+  public:
+    std::string secret     SWIFT_PRIVATE;
+    double id     SWIFT_PRIVATE;
+    SupportedAlgorithm algorithm     SWIFT_PRIVATE;
+    double digits     SWIFT_PRIVATE;
+    double period     SWIFT_PRIVATE;
+    double counter     SWIFT_PRIVATE;
+
+  public:
+    NitroKeyVaultRecord() = default;
+    explicit NitroKeyVaultRecord(std::string secret, double id, SupportedAlgorithm algorithm, double digits, double period, double counter): secret(secret), id(id), algorithm(algorithm), digits(digits), period(period), counter(counter) {}
+  };
+
+} // namespace margelo::nitro::totp
+
+namespace margelo::nitro {
+
+  // C++ NitroKeyVaultRecord <> JS NitroKeyVaultRecord (object)
+  template <>
+  struct JSIConverter<margelo::nitro::totp::NitroKeyVaultRecord> final {
+    static inline margelo::nitro::totp::NitroKeyVaultRecord fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::totp::NitroKeyVaultRecord(
+        JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, "secret")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "id")),
+        JSIConverter<margelo::nitro::totp::SupportedAlgorithm>::fromJSI(runtime, obj.getProperty(runtime, "algorithm")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "digits")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "period")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "counter"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::totp::NitroKeyVaultRecord& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "secret", JSIConverter<std::string>::toJSI(runtime, arg.secret));
+      obj.setProperty(runtime, "id", JSIConverter<double>::toJSI(runtime, arg.id));
+      obj.setProperty(runtime, "algorithm", JSIConverter<margelo::nitro::totp::SupportedAlgorithm>::toJSI(runtime, arg.algorithm));
+      obj.setProperty(runtime, "digits", JSIConverter<double>::toJSI(runtime, arg.digits));
+      obj.setProperty(runtime, "period", JSIConverter<double>::toJSI(runtime, arg.period));
+      obj.setProperty(runtime, "counter", JSIConverter<double>::toJSI(runtime, arg.counter));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, "secret"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "id"))) return false;
+      if (!JSIConverter<margelo::nitro::totp::SupportedAlgorithm>::canConvert(runtime, obj.getProperty(runtime, "algorithm"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "digits"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "period"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "counter"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,100 @@
+///
+/// NitroOtpAuthURI.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `OtpAuthType` to properly resolve imports.
+namespace margelo::nitro::totp { enum class OtpAuthType; }
+// Forward declaration of `SupportedAlgorithm` to properly resolve imports.
+namespace margelo::nitro::totp { enum class SupportedAlgorithm; }
+
+#include "OtpAuthType.hpp"
+#include <string>
+#include "SupportedAlgorithm.hpp"
+
+namespace margelo::nitro::totp {
+
+  /**
+   * A struct which can be represented as a JavaScript object (NitroOtpAuthURI).
+   */
+  struct NitroOtpAuthURI {
+  public:
+    OtpAuthType type     SWIFT_PRIVATE;
+    std::string issuer     SWIFT_PRIVATE;
+    std::string label     SWIFT_PRIVATE;
+    std::string secret     SWIFT_PRIVATE;
+    SupportedAlgorithm algorithm     SWIFT_PRIVATE;
+    double digits     SWIFT_PRIVATE;
+    double period     SWIFT_PRIVATE;
+    double counter     SWIFT_PRIVATE;
+
+  public:
+    NitroOtpAuthURI() = default;
+    explicit NitroOtpAuthURI(OtpAuthType type, std::string issuer, std::string label, std::string secret, SupportedAlgorithm algorithm, double digits, double period, double counter): type(type), issuer(issuer), label(label), secret(secret), algorithm(algorithm), digits(digits), period(period), counter(counter) {}
+  };
+
+} // namespace margelo::nitro::totp
+
+namespace margelo::nitro {
+
+  // C++ NitroOtpAuthURI <> JS NitroOtpAuthURI (object)
+  template <>
+  struct JSIConverter<margelo::nitro::totp::NitroOtpAuthURI> final {
+    static inline margelo::nitro::totp::NitroOtpAuthURI fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::totp::NitroOtpAuthURI(
+        JSIConverter<margelo::nitro::totp::OtpAuthType>::fromJSI(runtime, obj.getProperty(runtime, "type")),
+        JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, "issuer")),
+        JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, "label")),
+        JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, "secret")),
+        JSIConverter<margelo::nitro::totp::SupportedAlgorithm>::fromJSI(runtime, obj.getProperty(runtime, "algorithm")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "digits")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "period")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "counter"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::totp::NitroOtpAuthURI& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "type", JSIConverter<margelo::nitro::totp::OtpAuthType>::toJSI(runtime, arg.type));
+      obj.setProperty(runtime, "issuer", JSIConverter<std::string>::toJSI(runtime, arg.issuer));
+      obj.setProperty(runtime, "label", JSIConverter<std::string>::toJSI(runtime, arg.label));
+      obj.setProperty(runtime, "secret", JSIConverter<std::string>::toJSI(runtime, arg.secret));
+      obj.setProperty(runtime, "algorithm", JSIConverter<margelo::nitro::totp::SupportedAlgorithm>::toJSI(runtime, arg.algorithm));
+      obj.setProperty(runtime, "digits", JSIConverter<double>::toJSI(runtime, arg.digits));
+      obj.setProperty(runtime, "period", JSIConverter<double>::toJSI(runtime, arg.period));
+      obj.setProperty(runtime, "counter", JSIConverter<double>::toJSI(runtime, arg.counter));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<margelo::nitro::totp::OtpAuthType>::canConvert(runtime, obj.getProperty(runtime, "type"))) return false;
+      if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, "issuer"))) return false;
+      if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, "label"))) return false;
+      if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, "secret"))) return false;
+      if (!JSIConverter<margelo::nitro::totp::SupportedAlgorithm>::canConvert(runtime, obj.getProperty(runtime, "algorithm"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "digits"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "period"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "counter"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,75 @@
+///
+/// NitroTotpCodeUpdate.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <string>
+
+namespace margelo::nitro::totp {
+
+  /**
+   * A struct which can be represented as a JavaScript object (NitroTotpCodeUpdate).
+   */
+  struct NitroTotpCodeUpdate {
+  public:
+    double index     SWIFT_PRIVATE;
+    std::string code     SWIFT_PRIVATE;
+    double secondsRemaining     SWIFT_PRIVATE;
+
+  public:
+    NitroTotpCodeUpdate() = default;
+    explicit NitroTotpCodeUpdate(double index, std::string code, double secondsRemaining): index(index), code(code), secondsRemaining(secondsRemaining) {}
+  };
+
+} // namespace margelo::nitro::totp
+
+namespace margelo::nitro {
+
+  // C++ NitroTotpCodeUpdate <> JS NitroTotpCodeUpdate (object)
+  template <>
+  struct JSIConverter<margelo::nitro::totp::NitroTotpCodeUpdate> final {
+    static inline margelo::nitro::totp::NitroTotpCodeUpdate fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::totp::NitroTotpCodeUpdate(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "index")),
+        JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, "code")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "secondsRemaining"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::totp::NitroTotpCodeUpdate& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "index", JSIConverter<double>::toJSI(runtime, arg.index));
+      obj.setProperty(runtime, "code", JSIConverter<std::string>::toJSI(runtime, arg.code));
+      obj.setProperty(runtime, "secondsRemaining", JSIConverter<double>::toJSI(runtime, arg.secondsRemaining));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "index"))) return false;
+      if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, "code"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "secondsRemaining"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
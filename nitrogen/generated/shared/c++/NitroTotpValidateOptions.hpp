@@ -33,13 +33,15 @@ namespace margelo::nitro::totp {
   public:
     std::optional<double> period     SWIFT_PRIVATE;
     std::optional<double> currentTime     SWIFT_PRIVATE;
+    std::optional<bool> replayProtection     SWIFT_PRIVATE;
     std::optional<double> window     SWIFT_PRIVATE;
+    std::optional<bool> constantTime     SWIFT_PRIVATE;
     std::optional<double> digits     SWIFT_PRIVATE;
     std::optional<SupportedAlgorithm> algorithm     SWIFT_PRIVATE;
 
   public:
     NitroTotpValidateOptions() = default;
-    explicit NitroTotpValidateOptions(std::optional<double> period, std::optional<double> currentTime, std::optional<double> window, std::optional<double> digits, std::optional<SupportedAlgorithm> algorithm): period(period), currentTime(currentTime), window(window), digits(digits), algorithm(algorithm) {}
+    explicit NitroTotpValidateOptions(std::optional<double> period, std::optional<double> currentTime, std::optional<bool> replayProtection, std::optional<double> window, std::optional<bool> constantTime, std::optional<double> digits, std::optional<SupportedAlgorithm> algorithm): period(period), currentTime(currentTime), replayProtection(replayProtection), window(window), constantTime(constantTime), digits(digits), algorithm(algorithm) {}
   };
 
 } // namespace margelo::nitro::totp
@@ -54,7 +56,9 @@ namespace margelo::nitro {
       return margelo::nitro::totp::NitroTotpValidateOptions(
         JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "period")),
         JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "currentTime")),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "replayProtection")),
         JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "window")),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "constantTime")),
         JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "digits")),
         JSIConverter<std::optional<margelo::nitro::totp::SupportedAlgorithm>>::fromJSI(runtime, obj.getProperty(runtime, "algorithm"))
       );
@@ -63,7 +67,9 @@ namespace margelo::nitro {
       jsi::Object obj(runtime);
       obj.setProperty(runtime, "period", JSIConverter<std::optional<double>>::toJSI(runtime, arg.period));
       obj.setProperty(runtime, "currentTime", JSIConverter<std::optional<double>>::toJSI(runtime, arg.currentTime));
+      obj.setProperty(runtime, "replayProtection", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.replayProtection));
       obj.setProperty(runtime, "window", JSIConverter<std::optional<double>>::toJSI(runtime, arg.window));
+      obj.setProperty(runtime, "constantTime", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.constantTime));
       obj.setProperty(runtime, "digits", JSIConverter<std::optional<double>>::toJSI(runtime, arg.digits));
       obj.setProperty(runtime, "algorithm", JSIConverter<std::optional<margelo::nitro::totp::SupportedAlgorithm>>::toJSI(runtime, arg.algorithm));
       return obj;
@@ -75,7 +81,9 @@ namespace margelo::nitro {
       jsi::Object obj = value.getObject(runtime);
       if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "period"))) return false;
       if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "currentTime"))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "replayProtection"))) return false;
       if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "window"))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "constantTime"))) return false;
       if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "digits"))) return false;
       if (!JSIConverter<std::optional<margelo::nitro::totp::SupportedAlgorithm>>::canConvert(runtime, obj.getProperty(runtime, "algorithm"))) return false;
       return true;
@@ -0,0 +1,62 @@
+///
+/// OtpAuthType.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::totp {
+
+  /**
+   * An enum which can be represented as a JavaScript enum (OtpAuthType).
+   */
+  enum class OtpAuthType {
+    TOTP      SWIFT_NAME(totp) = 0,
+    HOTP      SWIFT_NAME(hotp) = 1,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::totp
+
+namespace margelo::nitro {
+
+  // C++ OtpAuthType <> JS OtpAuthType (enum)
+  template <>
+  struct JSIConverter<margelo::nitro::totp::OtpAuthType> final {
+    static inline margelo::nitro::totp::OtpAuthType fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      int enumValue = JSIConverter<int>::fromJSI(runtime, arg);
+      return static_cast<margelo::nitro::totp::OtpAuthType>(enumValue);
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, margelo::nitro::totp::OtpAuthType arg) {
+      int enumValue = static_cast<int>(arg);
+      return JSIConverter<int>::toJSI(runtime, enumValue);
+    }
+    static inline bool canConvert(jsi::Runtime&, const jsi::Value& value) {
+      if (!value.isNumber()) {
+        return false;
+      }
+      double number = value.getNumber();
+      int integer = static_cast<int>(number);
+      if (number != integer) {
+        // The integer is not the same value as the double - we truncated floating points.
+        // Enums are all integers, so the input floating point number is obviously invalid.
+        return false;
+      }
+      // Check if we are within the bounds of the enum.
+      return integer >= 0 && integer <= 1;
+    }
+  };
+
+} // namespace margelo::nitro
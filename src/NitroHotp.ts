@@ -3,7 +3,9 @@ import type { NitroHotp as NitroHotpType } from './specs/NitroHotp.nitro';
 import type {
   NitroHotpGenerateOptions,
   NitroHotpValidateOptions,
+  NitroKeyCacheStats,
   OTPAuthURLOptions,
+  SecretInput,
 } from './types';
 import { SupportedAlgorithm } from './types';
 import { NitroTotpConstants } from './constants';
@@ -22,11 +24,158 @@ export class NitroHotp {
   /**
    * Generates an HOTP code based on the secret key and options.
    *
-   * @param secret - The secret key to use for generating the HOTP.
+   * @param secret - The secret to generate the HOTP for.
    * @param options - Optional parameters for HOTP generation.
    * @returns The generated HOTP code as a string.
    */
-  generate(secret: string, options: NitroHotpGenerateOptions = {}): string {
+  generate(
+    secret: SecretInput,
+    options: NitroHotpGenerateOptions = {}
+  ): string {
+    return this.nitroHotp.generate(secret, this.withGenerateDefaults(options));
+  }
+
+  /**
+   * Generates an HOTP code on a native worker thread, keeping the JS thread free.
+   *
+   * @param secret - The secret to generate the HOTP for.
+   * @param options - Optional parameters for HOTP generation.
+   * @returns A promise resolving to the generated HOTP code.
+   */
+  generateAsync(
+    secret: SecretInput,
+    options: NitroHotpGenerateOptions = {}
+  ): Promise<string> {
+    return this.nitroHotp.generateAsync(
+      secret,
+      this.withGenerateDefaults(options)
+    );
+  }
+
+  /**
+   * Generates HOTP codes for many secret keys in a single native call.
+   *
+   * @param secrets - The secret keys to generate HOTPs for.
+   * @param options - Optional parameters for HOTP generation, shared by all secrets.
+   * @returns The generated HOTP codes, in the same order as `secrets`.
+   */
+  generateMany(
+    secrets: string[],
+    options: NitroHotpGenerateOptions = {}
+  ): string[] {
+    return this.nitroHotp.generateMany(
+      secrets,
+      this.withGenerateDefaults(options)
+    );
+  }
+
+  /**
+   * Generates HOTP codes for many secret keys on a native worker thread.
+   *
+   * @param secrets - The secret keys to generate HOTPs for.
+   * @param options - Optional parameters for HOTP generation, shared by all secrets.
+   * @returns A promise resolving to the generated HOTP codes, in the same order as `secrets`.
+   */
+  generateManyAsync(
+    secrets: string[],
+    options: NitroHotpGenerateOptions = {}
+  ): Promise<string[]> {
+    return this.nitroHotp.generateManyAsync(
+      secrets,
+      this.withGenerateDefaults(options)
+    );
+  }
+
+  /**
+   * Validates an HOTP code against the secret key and options.
+   *
+   * @param secret - The secret to validate against.
+   * @param otp - The HOTP code to validate.
+   * @param options - Optional parameters for HOTP validation.
+   * @returns True if the HOTP code is valid, false otherwise.
+   */
+  validate(
+    secret: SecretInput,
+    otp: string,
+    options: NitroHotpValidateOptions = {}
+  ): boolean {
+    return this.nitroHotp.validate(
+      secret,
+      otp,
+      this.withValidateDefaults(options)
+    );
+  }
+
+  /**
+   * Validates an HOTP code on a native worker thread, keeping the JS thread free.
+   *
+   * @param secret - The secret to validate against.
+   * @param otp - The HOTP code to validate.
+   * @param options - Optional parameters for HOTP validation.
+   * @returns A promise resolving to true if the HOTP code is valid, false otherwise.
+   */
+  validateAsync(
+    secret: SecretInput,
+    otp: string,
+    options: NitroHotpValidateOptions = {}
+  ): Promise<boolean> {
+    return this.nitroHotp.validateAsync(
+      secret,
+      otp,
+      this.withValidateDefaults(options)
+    );
+  }
+
+  /**
+   * Validates an HOTP code and returns the offset of the matching counter.
+   * Useful for resynchronization: persist `counter + delta + 1` as the next counter.
+   *
+   * @param secret - The secret to validate against.
+   * @param otp - The HOTP code to validate.
+   * @param options - Optional parameters for HOTP validation. Set `parallel` to split large windows across native threads.
+   * @returns The offset from `options.counter` of the matching counter, or undefined if the HOTP code is invalid.
+   */
+  validateDelta(
+    secret: SecretInput,
+    otp: string,
+    options: NitroHotpValidateOptions = {}
+  ): number | undefined {
+    return this.nitroHotp.validateDelta(
+      secret,
+      otp,
+      this.withValidateDefaults(options)
+    );
+  }
+
+  /**
+   * Validates an HOTP code on a native worker thread and returns the offset of the matching counter.
+   *
+   * @param secret - The secret to validate against.
+   * @param otp - The HOTP code to validate.
+   * @param options - Optional parameters for HOTP validation.
+   * @returns A promise resolving to the offset from `options.counter` of the matching counter, or undefined if the HOTP code is invalid.
+   */
+  validateDeltaAsync(
+    secret: SecretInput,
+    otp: string,
+    options: NitroHotpValidateOptions = {}
+  ): Promise<number | undefined> {
+    return this.nitroHotp.validateDeltaAsync(
+      secret,
+      otp,
+      this.withValidateDefaults(options)
+    );
+  }
+
+  /**
+   * Fills in default values for HOTP generation options.
+   *
+   * @param options - The options passed by the caller.
+   * @returns The same options object with defaults applied.
+   */
+  private withGenerateDefaults(
+    options: NitroHotpGenerateOptions
+  ): NitroHotpGenerateOptions {
     if (!options.digits) {
       options.digits = NitroTotpConstants.DEFAULT_DIGITS;
     }
@@ -39,22 +188,18 @@ export class NitroHotp {
       options.counter = NitroTotpConstants.DEFAULT_COUNTER;
     }
 
-    return this.nitroHotp.generate(secret, options);
+    return options;
   }
 
   /**
-   * Validates an HOTP code against the secret key and options.
+   * Fills in default values for HOTP validation options.
    *
-   * @param secret - The secret key to validate against.
-   * @param otp - The HOTP code to validate.
-   * @param options - Optional parameters for HOTP validation.
-   * @returns True if the HOTP code is valid, false otherwise.
+   * @param options - The options passed by the caller.
+   * @returns The same options object with defaults applied.
    */
-  validate(
-    secret: string,
-    otp: string,
-    options: NitroHotpValidateOptions = {}
-  ): boolean {
+  private withValidateDefaults(
+    options: NitroHotpValidateOptions
+  ): NitroHotpValidateOptions {
     if (!options.digits) {
       options.digits = NitroTotpConstants.DEFAULT_DIGITS;
     }
@@ -79,7 +224,24 @@ export class NitroHotp {
       options.counter = NitroTotpConstants.DEFAULT_COUNTER;
     }
 
-    return this.nitroHotp.validate(secret, otp, options);
+    return options;
+  }
+
+  /**
+   * Returns hit/miss counters of the native cache of decoded secrets.
+   * The cache is shared by all NitroTotp and NitroHotp instances.
+   *
+   * @returns The current cache statistics.
+   */
+  getKeyCacheStats(): NitroKeyCacheStats {
+    return this.nitroHotp.getKeyCacheStats();
+  }
+
+  /**
+   * Wipes and removes every cached secret, e.g. when the user signs out.
+   */
+  clearKeyCache(): void {
+    this.nitroHotp.clearKeyCache();
   }
 
   /**
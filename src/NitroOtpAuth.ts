@@ -0,0 +1,59 @@
+import { NitroModules } from 'react-native-nitro-modules';
+import type { NitroOtpAuth as NitroOtpAuthType } from './specs/NitroOtpAuth.nitro';
+import type { NitroOtpAuthAccount, NitroOtpAuthURI } from './types';
+
+/**
+ * NitroOtpAuth class that parses and builds `otpauth://` URIs natively, e.g. for bulk account import and export.
+ */
+export class NitroOtpAuth {
+  private nitroOtpAuth: NitroOtpAuthType;
+
+  constructor() {
+    this.nitroOtpAuth =
+      NitroModules.createHybridObject<NitroOtpAuthType>('NitroOtpAuth');
+  }
+
+  /**
+   * Parses an `otpauth://totp/...` or `otpauth://hotp/...` URI.
+   *
+   * @param uri - The URI, e.g. scanned from a QR code.
+   * @returns The account described by the URI, with defaults for missing parameters.
+   * @throws If the URI is malformed, has no account name or valid Base32 secret, or repeats a parameter.
+   */
+  parse(uri: string): NitroOtpAuthURI {
+    return this.nitroOtpAuth.parse(uri);
+  }
+
+  /**
+   * Parses many URIs in a single native call.
+   *
+   * @param uris - The URIs to parse.
+   * @returns The parsed accounts, in the same order as `uris`; undefined for each URI that is invalid.
+   */
+  parseMany(uris: string[]): (NitroOtpAuthURI | undefined)[] {
+    return this.nitroOtpAuth.parseMany(uris);
+  }
+
+  /**
+   * Builds the `otpauth://` URI of an account, e.g. for a QR code.
+   *
+   * @param uri - The account to encode.
+   * @param issuerInLabel - Whether to also prefix the label with the issuer.
+   * @returns The URI as a string.
+   */
+  build(uri: NitroOtpAuthURI, issuerInLabel: boolean = false): string {
+    return this.nitroOtpAuth.build(uri, issuerInLabel);
+  }
+
+  /**
+   * Decodes a Google Authenticator export QR code (`otpauth-migration://offline?data=...`).
+   * Each account's secret goes straight into a native key handle, so the key bytes never reach JS.
+   *
+   * @param uri - The migration URI.
+   * @returns The exported accounts, in export order.
+   * @throws If the URI or its payload is malformed, or an account uses an unsupported algorithm.
+   */
+  parseMigration(uri: string): NitroOtpAuthAccount[] {
+    return this.nitroOtpAuth.parseMigration(uri);
+  }
+}
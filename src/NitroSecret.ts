@@ -1,8 +1,10 @@
 import { NitroModules } from 'react-native-nitro-modules';
 import type { NitroSecret as NitroSecretType } from './specs/NitroSecret.nitro';
-import type { GenerateSecretKeyOptions } from './types';
+import type { NitroKeyVault } from './specs/NitroKeyVault.nitro';
+import type { NitroTotpKey } from './specs/NitroTotpKey.nitro';
+import type { GenerateSecretKeyOptions, NitroKeyVaultRecord } from './types';
 import { NitroTotpConstants, SecretSizeBytes } from './constants';
-import { SecretSize } from './types';
+import { SecretSize, SupportedAlgorithm } from './types';
 
 /**
  * NitroSecret class that provides methods for generating cryptographically secure secrets.
@@ -27,6 +29,103 @@ export class NitroSecret {
     return this.nitroSecret.generate({ size: sizeInBytes });
   }
 
+  /**
+   * Generates a cryptographically secure random secret key on a native worker thread.
+   * @param options - Optional parameters for secret generation.
+   * @returns A promise resolving to the generated secret as a Base32-encoded string.
+   */
+  generateAsync(options: GenerateSecretKeyOptions = {}): Promise<string> {
+    const size = options.size ?? NitroTotpConstants.DEFAULT_SECRET_SIZE;
+    const sizeInBytes = this.convertToBytes(size);
+
+    return this.nitroSecret.generateAsync({ size: sizeInBytes });
+  }
+
+  /**
+   * Generates many cryptographically secure random secret keys in a single native call.
+   * The random bytes for all secrets are drawn from the system CSPRNG at once.
+   * @param count - Number of secrets to generate.
+   * @param options - Optional parameters for secret generation, shared by all secrets.
+   * @returns The generated secrets as unpadded Base32-encoded strings.
+   */
+  generateMany(
+    count: number,
+    options: GenerateSecretKeyOptions = {}
+  ): string[] {
+    const size = options.size ?? NitroTotpConstants.DEFAULT_SECRET_SIZE;
+    const sizeInBytes = this.convertToBytes(size);
+
+    return this.nitroSecret.generateMany(count, { size: sizeInBytes });
+  }
+
+  /**
+   * Generates many cryptographically secure random secret keys on a native worker thread.
+   * @param count - Number of secrets to generate.
+   * @param options - Optional parameters for secret generation, shared by all secrets.
+   * @returns A promise resolving to the generated secrets as unpadded Base32-encoded strings.
+   */
+  generateManyAsync(
+    count: number,
+    options: GenerateSecretKeyOptions = {}
+  ): Promise<string[]> {
+    const size = options.size ?? NitroTotpConstants.DEFAULT_SECRET_SIZE;
+    const sizeInBytes = this.convertToBytes(size);
+
+    return this.nitroSecret.generateManyAsync(count, { size: sizeInBytes });
+  }
+
+  /**
+   * Generates a cryptographically secure random secret key as raw bytes,
+   * skipping Base32 encoding. Useful when the key goes straight into secure
+   * storage, and accepted as-is by `generate`/`validate` and `createKey`.
+   * @param options - Optional parameters for secret generation.
+   * @returns The generated secret bytes.
+   */
+  generateBytes(options: GenerateSecretKeyOptions = {}): ArrayBuffer {
+    const size = options.size ?? NitroTotpConstants.DEFAULT_SECRET_SIZE;
+    const sizeInBytes = this.convertToBytes(size);
+
+    return this.nitroSecret.generateBytes({ size: sizeInBytes });
+  }
+
+  /**
+   * Decodes a secret once into a native key handle. Pass the handle to
+   * `generate`/`validate` instead of the string to skip decoding and keep the
+   * key bytes out of the JS heap. The handle's algorithm overrides the
+   * `algorithm` option of those calls.
+   * @param secret - The Base32-encoded secret key, or its raw bytes.
+   * @param algorithm - The HMAC algorithm the key is prepared for.
+   * @returns An opaque key handle.
+   */
+  createKey(
+    secret: string | ArrayBuffer,
+    algorithm: SupportedAlgorithm = NitroTotpConstants.DEFAULT_ALGORITHM
+  ): NitroTotpKey {
+    return this.nitroSecret.createKey(secret, algorithm);
+  }
+
+  /**
+   * Writes accounts to a compact binary vault file, replacing any existing
+   * file at `path` only once the new one is complete. The file holds key
+   * bytes in the clear, so keep it in app-private or encrypted storage.
+   * @param path - The file path to write.
+   * @param records - The accounts, each with a unique integer `id`.
+   */
+  writeVault(path: string, records: NitroKeyVaultRecord[]): void {
+    this.nitroSecret.writeVault(path, records);
+  }
+
+  /**
+   * Maps a vault written by `writeVault` into memory. Opening reads only the
+   * header, and records are paged in as they are used, so it stays cheap for
+   * thousands of accounts.
+   * @param path - The vault file path.
+   * @returns A vault handle; call `close()` to unmap it.
+   */
+  openVault(path: string): NitroKeyVault {
+    return this.nitroSecret.openVault(path);
+  }
+
   /**
    * Validates if the given secret key has a valid format.
    * @param secretKey - The secret key to check.
@@ -1,9 +1,14 @@
 import { NitroModules } from 'react-native-nitro-modules';
 import type { NitroTotp as NitroTotpType } from './specs/NitroTotp.nitro';
+import type { NitroTotpKey } from './specs/NitroTotpKey.nitro';
 import type {
   NitroTotpGenerateOptions,
   NitroTotpValidateOptions,
+  NitroKeyCacheStats,
+  NitroTotpCodeUpdate,
+  NitroTotpSubscribeOptions,
   OTPAuthURLOptions,
+  SecretInput,
 } from './types';
 import { SupportedAlgorithm } from './types';
 import { NitroTotpConstants } from './constants';
@@ -22,11 +27,202 @@ export class NitroTotp {
   /**
    * Generates a TOTP code based on the secret key and options.
    *
-   * @param secret - The secret key to use for generating the TOTP.
+   * @param secret - The secret to generate the TOTP for.
    * @param options - Optional parameters for TOTP generation.
    * @returns The generated TOTP code as a string.
    */
-  generate(secret: string, options: NitroTotpGenerateOptions = {}): string {
+  generate(
+    secret: SecretInput,
+    options: NitroTotpGenerateOptions = {}
+  ): string {
+    return this.nitroTotp.generate(secret, this.withGenerateDefaults(options));
+  }
+
+  /**
+   * Generates a TOTP code on a native worker thread, keeping the JS thread free.
+   *
+   * @param secret - The secret to generate the TOTP for.
+   * @param options - Optional parameters for TOTP generation.
+   * @returns A promise resolving to the generated TOTP code.
+   */
+  generateAsync(
+    secret: SecretInput,
+    options: NitroTotpGenerateOptions = {}
+  ): Promise<string> {
+    return this.nitroTotp.generateAsync(
+      secret,
+      this.withGenerateDefaults(options)
+    );
+  }
+
+  /**
+   * Generates TOTP codes for many secret keys in a single native call.
+   *
+   * @param secrets - The secret keys to generate TOTPs for.
+   * @param options - Optional parameters for TOTP generation, shared by all secrets.
+   * @returns The generated TOTP codes, in the same order as `secrets`.
+   */
+  generateMany(
+    secrets: string[],
+    options: NitroTotpGenerateOptions = {}
+  ): string[] {
+    return this.nitroTotp.generateMany(
+      secrets,
+      this.withGenerateDefaults(options)
+    );
+  }
+
+  /**
+   * Generates TOTP codes for many secret keys on a native worker thread.
+   *
+   * @param secrets - The secret keys to generate TOTPs for.
+   * @param options - Optional parameters for TOTP generation, shared by all secrets.
+   * @returns A promise resolving to the generated TOTP codes, in the same order as `secrets`.
+   */
+  generateManyAsync(
+    secrets: string[],
+    options: NitroTotpGenerateOptions = {}
+  ): Promise<string[]> {
+    return this.nitroTotp.generateManyAsync(
+      secrets,
+      this.withGenerateDefaults(options)
+    );
+  }
+
+  /**
+   * Validates a TOTP code against the secret key and options.
+   *
+   * @param secret - The secret to validate against.
+   * @param otp - The TOTP code to validate.
+   * @param options - Optional parameters for TOTP validation.
+   * @returns True if the TOTP code is valid, false otherwise.
+   */
+  validate(
+    secret: SecretInput,
+    otp: string,
+    options: NitroTotpValidateOptions = {}
+  ): boolean {
+    return this.nitroTotp.validate(
+      secret,
+      otp,
+      this.withValidateDefaults(options)
+    );
+  }
+
+  /**
+   * Validates a TOTP code on a native worker thread, keeping the JS thread free.
+   *
+   * @param secret - The secret to validate against.
+   * @param otp - The TOTP code to validate.
+   * @param options - Optional parameters for TOTP validation.
+   * @returns A promise resolving to true if the TOTP code is valid, false otherwise.
+   */
+  validateAsync(
+    secret: SecretInput,
+    otp: string,
+    options: NitroTotpValidateOptions = {}
+  ): Promise<boolean> {
+    return this.nitroTotp.validateAsync(
+      secret,
+      otp,
+      this.withValidateDefaults(options)
+    );
+  }
+
+  /**
+   * Validates a TOTP code and returns the offset of the matching time step.
+   * With `replayProtection`, a code is accepted at most once per key handle.
+   *
+   * @param secret - The secret to validate against. Replay protection requires a key handle.
+   * @param otp - The TOTP code to validate.
+   * @param options - Optional parameters for TOTP validation.
+   * @returns The offset in time steps from the current step of the matching step, or undefined if the TOTP code is invalid or replayed.
+   */
+  validateDelta(
+    secret: SecretInput,
+    otp: string,
+    options: NitroTotpValidateOptions = {}
+  ): number | undefined {
+    return this.nitroTotp.validateDelta(
+      secret,
+      otp,
+      this.withValidateDefaults(options)
+    );
+  }
+
+  /**
+   * Validates a TOTP code on a native worker thread and returns the offset of the matching time step.
+   *
+   * @param secret - The secret to validate against. Replay protection requires a key handle.
+   * @param otp - The TOTP code to validate.
+   * @param options - Optional parameters for TOTP validation.
+   * @returns A promise resolving to the offset of the matching time step, or undefined if the TOTP code is invalid or replayed.
+   */
+  validateDeltaAsync(
+    secret: SecretInput,
+    otp: string,
+    options: NitroTotpValidateOptions = {}
+  ): Promise<number | undefined> {
+    return this.nitroTotp.validateDeltaAsync(
+      secret,
+      otp,
+      this.withValidateDefaults(options)
+    );
+  }
+
+  /**
+   * Validates many (secret, code) pairs at the same timestamp in one native
+   * call, e.g. for a burst of logins on a server. Keys are grouped by
+   * algorithm and checked in batches on native worker threads. Every
+   * candidate is computed, so timing does not depend on where codes match.
+   *
+   * @param secrets - The secrets to validate against.
+   * @param otps - The codes to validate, one per secret.
+   * @param options - Optional parameters for TOTP validation, shared by all pairs.
+   * @returns The offset of the matching time step per pair, or `NitroTotpConstants.NO_MATCH`, also for an empty or non-Base32 secret.
+   */
+  validateMany(
+    secrets: SecretInput[],
+    otps: string[],
+    options: NitroTotpValidateOptions = {}
+  ): Int32Array {
+    return new Int32Array(
+      this.nitroTotp.validateMany(
+        secrets,
+        otps,
+        this.withValidateDefaults(options)
+      )
+    );
+  }
+
+  /**
+   * Validates many (secret, code) pairs on native worker threads without
+   * blocking the JS thread.
+   *
+   * @param secrets - The secrets to validate against.
+   * @param otps - The codes to validate, one per secret.
+   * @param options - Optional parameters for TOTP validation, shared by all pairs.
+   * @returns A promise resolving to the offset of the matching time step per pair, or `NitroTotpConstants.NO_MATCH`, also for an empty or non-Base32 secret.
+   */
+  validateManyAsync(
+    secrets: SecretInput[],
+    otps: string[],
+    options: NitroTotpValidateOptions = {}
+  ): Promise<Int32Array> {
+    return this.nitroTotp
+      .validateManyAsync(secrets, otps, this.withValidateDefaults(options))
+      .then((deltas) => new Int32Array(deltas));
+  }
+
+  /**
+   * Fills in default values for TOTP generation options.
+   *
+   * @param options - The options passed by the caller.
+   * @returns The same options object with defaults applied.
+   */
+  private withGenerateDefaults(
+    options: NitroTotpGenerateOptions
+  ): NitroTotpGenerateOptions {
     if (!options.digits) {
       options.digits = NitroTotpConstants.DEFAULT_DIGITS;
     }
@@ -43,22 +239,18 @@ export class NitroTotp {
       options.currentTime = Math.floor(Date.now() / 1000);
     }
 
-    return this.nitroTotp.generate(secret, options);
+    return options;
   }
 
   /**
-   * Validates a TOTP code against the secret key and options.
+   * Fills in default values for TOTP validation options.
    *
-   * @param secret - The secret key to validate against.
-   * @param otp - The TOTP code to validate.
-   * @param options - Optional parameters for TOTP validation.
-   * @returns True if the TOTP code is valid, false otherwise.
+   * @param options - The options passed by the caller.
+   * @returns The same options object with defaults applied.
    */
-  validate(
-    secret: string,
-    otp: string,
-    options: NitroTotpValidateOptions = {}
-  ): boolean {
+  private withValidateDefaults(
+    options: NitroTotpValidateOptions
+  ): NitroTotpValidateOptions {
     if (!options.digits) {
       options.digits = NitroTotpConstants.DEFAULT_DIGITS;
     }
@@ -83,7 +275,74 @@ export class NitroTotp {
       options.currentTime = Math.floor(Date.now() / 1000);
     }
 
-    return this.nitroTotp.validate(secret, otp, options);
+    return options;
+  }
+
+  /**
+   * Returns hit/miss counters of the native cache of decoded secrets.
+   * The cache is shared by all NitroTotp and NitroHotp instances.
+   *
+   * @returns The current cache statistics.
+   */
+  getKeyCacheStats(): NitroKeyCacheStats {
+    return this.nitroTotp.getKeyCacheStats();
+  }
+
+  /**
+   * Wipes and removes every cached secret, e.g. when the user signs out.
+   */
+  clearKeyCache(): void {
+    this.nitroTotp.clearKeyCache();
+  }
+
+  /**
+   * Pushes the current code of each key, and every later change, to `onUpdate`.
+   * Codes are computed natively once per period boundary, so a list of N
+   * accounts costs N HMACs per period instead of one per key per render.
+   *
+   * @param keys - Key handles from `NitroSecret.createKey`; at least one.
+   * @param onUpdate - Receives the codes that changed, identified by their index in `keys`.
+   * @param options - Optional period (one for all keys, or one per key) and digits.
+   * @returns A subscription id to pass to `unsubscribe`.
+   */
+  subscribe(
+    keys: NitroTotpKey[],
+    onUpdate: (updates: NitroTotpCodeUpdate[]) => void,
+    options: NitroTotpSubscribeOptions = {}
+  ): number {
+    const period = options.period ?? NitroTotpConstants.DEFAULT_PERIOD;
+    const periods = Array.isArray(period) ? period : [period];
+    const digits = options.digits ?? NitroTotpConstants.DEFAULT_DIGITS;
+
+    return this.nitroTotp.subscribe(keys, periods, digits, onUpdate);
+  }
+
+  /**
+   * Stops the updates of a subscription created by `subscribe`.
+   *
+   * @param subscriptionId - The id returned by `subscribe`.
+   */
+  unsubscribe(subscriptionId: number): void {
+    this.nitroTotp.unsubscribe(subscriptionId);
+  }
+
+  /**
+   * Computes the codes of the next `count` time steps for a key handle in one
+   * batched native pass. Later `generate` calls for the same key, period and
+   * digits read the stored code instead of computing an HMAC, and the buffer
+   * is topped up on a native worker thread as time moves on. After a gap of
+   * more than `count / 2` steps (e.g. a long suspend), call it again.
+   *
+   * @param key - A key handle from `NitroSecret.createKey`.
+   * @param count - Number of time steps to keep ready, starting at `options.currentTime` (at most 1024).
+   * @param options - Optional period, digits and start time, as for `generate`.
+   */
+  precompute(
+    key: NitroTotpKey,
+    count: number,
+    options: NitroTotpGenerateOptions = {}
+  ): void {
+    this.nitroTotp.precompute(key, count, this.withGenerateDefaults(options));
   }
 
   /**
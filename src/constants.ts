@@ -7,6 +7,8 @@ export const NitroTotpConstants = {
   DEFAULT_WINDOW: 1,
   DEFAULT_COUNTER: 0,
   DEFAULT_ALGORITHM: SupportedAlgorithm.SHA1,
+  // validateMany() result for codes that did not match (INT32_MIN)
+  NO_MATCH: -2147483648,
 } as const;
 
 export const SecretSizeBytes: Record<SecretSize, number> = {
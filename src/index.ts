@@ -1,6 +1,9 @@
 export { NitroTotp } from './NitroTotp';
 export { NitroHotp } from './NitroHotp';
 export { NitroSecret } from './NitroSecret';
+export { NitroOtpAuth } from './NitroOtpAuth';
+export type { NitroKeyVault } from './specs/NitroKeyVault.nitro';
+export type { NitroTotpKey } from './specs/NitroTotpKey.nitro';
 
 export * from './utils';
 export * from './types';
@@ -2,14 +2,45 @@ import type { HybridObject } from 'react-native-nitro-modules';
 import type {
   NitroHotpGenerateOptions,
   NitroHotpValidateOptions,
+  NitroKeyCacheStats,
 } from '../types';
+import type { NitroTotpKey } from './NitroTotpKey.nitro';
 
 export interface NitroHotp
   extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
-  generate(secret: string, options: NitroHotpGenerateOptions): string;
+  generate(
+    secret: string | NitroTotpKey | ArrayBuffer,
+    options: NitroHotpGenerateOptions
+  ): string;
+  generateAsync(
+    secret: string | NitroTotpKey | ArrayBuffer,
+    options: NitroHotpGenerateOptions
+  ): Promise<string>;
+  generateMany(secrets: string[], options: NitroHotpGenerateOptions): string[];
+  generateManyAsync(
+    secrets: string[],
+    options: NitroHotpGenerateOptions
+  ): Promise<string[]>;
   validate(
-    secret: string,
+    secret: string | NitroTotpKey | ArrayBuffer,
     otp: string,
     options: NitroHotpValidateOptions
   ): boolean;
+  validateAsync(
+    secret: string | NitroTotpKey | ArrayBuffer,
+    otp: string,
+    options: NitroHotpValidateOptions
+  ): Promise<boolean>;
+  validateDelta(
+    secret: string | NitroTotpKey | ArrayBuffer,
+    otp: string,
+    options: NitroHotpValidateOptions
+  ): number | undefined;
+  validateDeltaAsync(
+    secret: string | NitroTotpKey | ArrayBuffer,
+    otp: string,
+    options: NitroHotpValidateOptions
+  ): Promise<number | undefined>;
+  getKeyCacheStats(): NitroKeyCacheStats;
+  clearKeyCache(): void;
 }
@@ -0,0 +1,18 @@
+import type { HybridObject } from 'react-native-nitro-modules';
+import type { NitroKeyVaultEntry } from '../types';
+import type { NitroTotpKey } from './NitroTotpKey.nitro';
+
+/**
+ * A binary vault of accounts mapped into memory by `NitroSecret.openVault`.
+ * Records are read on demand, so opening costs the same for any number of
+ * accounts.
+ */
+export interface NitroKeyVault
+  extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  readonly size: number;
+  indexOf(id: number): number;
+  getEntry(index: number): NitroKeyVaultEntry;
+  createKey(index: number): NitroTotpKey;
+  generate(index: number, currentTime: number): string;
+  close(): void;
+}
@@ -0,0 +1,10 @@
+import type { HybridObject } from 'react-native-nitro-modules';
+import type { NitroOtpAuthAccount, NitroOtpAuthURI } from '../types';
+
+export interface NitroOtpAuth
+  extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  parse(uri: string): NitroOtpAuthURI;
+  parseMany(uris: string[]): (NitroOtpAuthURI | undefined)[];
+  build(uri: NitroOtpAuthURI, issuerInLabel: boolean): string;
+  parseMigration(uri: string): NitroOtpAuthAccount[];
+}
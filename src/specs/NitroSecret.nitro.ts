@@ -1,7 +1,26 @@
 import type { HybridObject } from 'react-native-nitro-modules';
-import type { GenerateSecretKeyOptions } from '../types';
+import type {
+  GenerateSecretKeyOptions,
+  NitroKeyVaultRecord,
+  SupportedAlgorithm,
+} from '../types';
+import type { NitroKeyVault } from './NitroKeyVault.nitro';
+import type { NitroTotpKey } from './NitroTotpKey.nitro';
 
 export interface NitroSecret
   extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
   generate(options: GenerateSecretKeyOptions): string;
+  generateAsync(options: GenerateSecretKeyOptions): Promise<string>;
+  generateMany(count: number, options: GenerateSecretKeyOptions): string[];
+  generateManyAsync(
+    count: number,
+    options: GenerateSecretKeyOptions
+  ): Promise<string[]>;
+  generateBytes(options: GenerateSecretKeyOptions): ArrayBuffer;
+  createKey(
+    secret: string | ArrayBuffer,
+    algorithm: SupportedAlgorithm
+  ): NitroTotpKey;
+  openVault(path: string): NitroKeyVault;
+  writeVault(path: string, records: NitroKeyVaultRecord[]): void;
 }
@@ -2,14 +2,68 @@ import type { HybridObject } from 'react-native-nitro-modules';
 import type {
   NitroTotpGenerateOptions,
   NitroTotpValidateOptions,
+  NitroKeyCacheStats,
+  NitroTotpCodeUpdate,
 } from '../types';
+import type { NitroTotpKey } from './NitroTotpKey.nitro';
 
 export interface NitroTotp
   extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
-  generate(secret: string, options: NitroTotpGenerateOptions): string;
+  generate(
+    secret: string | NitroTotpKey | ArrayBuffer,
+    options: NitroTotpGenerateOptions
+  ): string;
+  generateAsync(
+    secret: string | NitroTotpKey | ArrayBuffer,
+    options: NitroTotpGenerateOptions
+  ): Promise<string>;
+  generateMany(secrets: string[], options: NitroTotpGenerateOptions): string[];
+  generateManyAsync(
+    secrets: string[],
+    options: NitroTotpGenerateOptions
+  ): Promise<string[]>;
   validate(
-    secret: string,
+    secret: string | NitroTotpKey | ArrayBuffer,
     otp: string,
     options: NitroTotpValidateOptions
   ): boolean;
+  validateAsync(
+    secret: string | NitroTotpKey | ArrayBuffer,
+    otp: string,
+    options: NitroTotpValidateOptions
+  ): Promise<boolean>;
+  validateDelta(
+    secret: string | NitroTotpKey | ArrayBuffer,
+    otp: string,
+    options: NitroTotpValidateOptions
+  ): number | undefined;
+  validateDeltaAsync(
+    secret: string | NitroTotpKey | ArrayBuffer,
+    otp: string,
+    options: NitroTotpValidateOptions
+  ): Promise<number | undefined>;
+  validateMany(
+    secrets: (string | NitroTotpKey | ArrayBuffer)[],
+    otps: string[],
+    options: NitroTotpValidateOptions
+  ): ArrayBuffer;
+  validateManyAsync(
+    secrets: (string | NitroTotpKey | ArrayBuffer)[],
+    otps: string[],
+    options: NitroTotpValidateOptions
+  ): Promise<ArrayBuffer>;
+  getKeyCacheStats(): NitroKeyCacheStats;
+  clearKeyCache(): void;
+  subscribe(
+    keys: NitroTotpKey[],
+    periods: number[],
+    digits: number,
+    onUpdate: (updates: NitroTotpCodeUpdate[]) => void
+  ): number;
+  unsubscribe(subscriptionId: number): void;
+  precompute(
+    key: NitroTotpKey,
+    count: number,
+    options: NitroTotpGenerateOptions
+  ): void;
 }
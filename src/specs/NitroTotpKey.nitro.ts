@@ -0,0 +1,11 @@
+import type { HybridObject } from 'react-native-nitro-modules';
+import type { SupportedAlgorithm } from '../types';
+
+/**
+ * A decoded secret with its HMAC state prepared in native memory.
+ * Created by `NitroSecret.createKey`; the key bytes never re-enter JS.
+ */
+export interface NitroTotpKey
+  extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  readonly algorithm: SupportedAlgorithm;
+}
@@ -1,15 +1,30 @@
+import type { NitroTotpKey } from './specs/NitroTotpKey.nitro';
+
 export enum SupportedAlgorithm {
   SHA1,
   SHA256,
   SHA512,
 }
 
+export enum OtpAuthType {
+  TOTP,
+  HOTP,
+}
+
 export enum SecretSize {
   COMPACT = 0,
   STANDARD = 1,
   EXTENDED = 2,
 }
 
+/**
+ * A secret accepted by the generate and validate methods: the Base32-encoded
+ * secret key, its raw bytes as an `ArrayBuffer`, or a key handle from
+ * `NitroSecret.createKey`. A key handle carries its own algorithm, which
+ * overrides the `algorithm` option.
+ */
+export type SecretInput = string | ArrayBuffer | NitroTotpKey;
+
 export interface OTPAuthURLOptions extends BaseGenerateOptions {
   /**
    * The issuer of the secret key.
@@ -107,6 +122,15 @@ export interface BaseValidateOptions extends BaseGenerateOptions {
    * @default 1
    */
   window?: number;
+
+  /**
+   * Compares every candidate in the window without early exit or
+   * data-dependent branches, so validation time does not depend on whether
+   * or where the code matched. Takes precedence over `parallel`.
+   * @type {boolean}
+   * @default false
+   */
+  constantTime?: boolean;
 }
 
 export interface NitroHotpValidateOptions extends BaseValidateOptions {
@@ -116,6 +140,13 @@ export interface NitroHotpValidateOptions extends BaseValidateOptions {
    * @default 0
    */
   counter?: number;
+
+  /**
+   * Whether to split large windows (e.g. HOTP resync) across native worker threads.
+   * @type {boolean}
+   * @default false
+   */
+  parallel?: boolean;
 }
 
 export interface NitroTotpValidateOptions extends BaseValidateOptions {
@@ -132,4 +163,222 @@ export interface NitroTotpValidateOptions extends BaseValidateOptions {
    * @internal
    */
   currentTime?: number;
+
+  /**
+   * Rejects a code whose time step is not newer than the last step accepted
+   * for the same key, so each code can be used only once. Requires a key
+   * handle from `NitroSecret.createKey`.
+   * @type {boolean}
+   * @default false
+   */
+  replayProtection?: boolean;
+}
+
+export interface NitroKeyCacheStats {
+  /**
+   * Number of lookups served by an already prepared key.
+   * @type {number}
+   */
+  hits: number;
+
+  /**
+   * Number of lookups that had to decode the secret and prepare its key.
+   * @type {number}
+   */
+  misses: number;
+
+  /**
+   * Number of secrets evicted (and wiped) to stay within capacity.
+   * @type {number}
+   */
+  evictions: number;
+
+  /**
+   * Number of secrets currently cached.
+   * @type {number}
+   */
+  size: number;
+
+  /**
+   * Maximum number of secrets kept in the cache.
+   * @type {number}
+   */
+  capacity: number;
+}
+
+export interface NitroTotpCodeUpdate {
+  /**
+   * Position of the key in the array passed to `subscribe`.
+   * @type {number}
+   */
+  index: number;
+
+  /**
+   * The code for the current time step.
+   * @type {string}
+   */
+  code: string;
+
+  /**
+   * Whole seconds until the code changes, as of when the update was sent.
+   * @type {number}
+   */
+  secondsRemaining: number;
+}
+
+export interface NitroTotpSubscribeOptions {
+  /**
+   * Time step in seconds, either shared by all keys or one per key.
+   * @default 30
+   * @type {number | number[]}
+   */
+  period?: number | number[];
+
+  /**
+   * Number of digits in each code.
+   * @default 6
+   * @type {number}
+   */
+  digits?: number;
+}
+
+export interface NitroOtpAuthURI {
+  /**
+   * Whether the URI describes a TOTP or an HOTP account.
+   * @type {OtpAuthType}
+   */
+  type: OtpAuthType;
+
+  /**
+   * The issuer, from the `issuer` parameter or else the label prefix.
+   * Empty when the URI has neither.
+   * @type {string}
+   */
+  issuer: string;
+
+  /**
+   * The account name, without the issuer prefix.
+   * @type {string}
+   */
+  label: string;
+
+  /**
+   * The Base32 secret key, as written in the URI.
+   * @type {string}
+   */
+  secret: string;
+
+  /**
+   * The HMAC algorithm.
+   * @type {SupportedAlgorithm}
+   */
+  algorithm: SupportedAlgorithm;
+
+  /**
+   * The number of digits in each code.
+   * @type {number}
+   */
+  digits: number;
+
+  /**
+   * The period in seconds (TOTP only).
+   * @type {number}
+   */
+  period: number;
+
+  /**
+   * The counter (HOTP only).
+   * @type {number}
+   */
+  counter: number;
+}
+
+export interface NitroOtpAuthAccount {
+  /**
+   * Whether the account is a TOTP or an HOTP account.
+   * @type {OtpAuthType}
+   */
+  type: OtpAuthType;
+
+  /**
+   * The issuer of the account. May be empty.
+   * @type {string}
+   */
+  issuer: string;
+
+  /**
+   * The account name.
+   * @type {string}
+   */
+  label: string;
+
+  /**
+   * The HMAC algorithm the key is prepared for.
+   * @type {SupportedAlgorithm}
+   */
+  algorithm: SupportedAlgorithm;
+
+  /**
+   * The number of digits in each code.
+   * @type {number}
+   */
+  digits: number;
+
+  /**
+   * The period in seconds (TOTP only).
+   * @type {number}
+   */
+  period: number;
+
+  /**
+   * The counter (HOTP only).
+   * @type {number}
+   */
+  counter: number;
+
+  /**
+   * Native handle to the account's secret, which never enters JS.
+   * @type {NitroTotpKey}
+   */
+  key: NitroTotpKey;
+}
+
+export interface NitroKeyVaultEntry {
+  /**
+   * The account id, unique within the vault. An integer up to 2^53.
+   * @type {number}
+   */
+  id: number;
+
+  /**
+   * The HMAC algorithm of the account.
+   * @type {SupportedAlgorithm}
+   */
+  algorithm: SupportedAlgorithm;
+
+  /**
+   * The number of digits in each code.
+   * @type {number}
+   */
+  digits: number;
+
+  /**
+   * The period in seconds, or 0 for an HOTP account.
+   * @type {number}
+   */
+  period: number;
+
+  /**
+   * The counter (HOTP only).
+   * @type {number}
+   */
+  counter: number;
+}
+
+export interface NitroKeyVaultRecord extends NitroKeyVaultEntry {
+  /**
+   * The Base32-encoded secret, at most 64 bytes once decoded.
+   * @type {string}
+   */
+  secret: string;
 }